@@ -18,6 +18,7 @@
 **********************************************************************************************/
 
 #include "canvas/CCanvas.h"
+#include "canvas/CRenderStats.h"
 #include "config.h"
 #include "CAbout.h"
 #include "CMainWindow.h"
@@ -191,6 +192,7 @@ CMainWindow::CMainWindow()
     connect(actionShowScale,             &QAction::changed,              this,      &CMainWindow::slotUpdateTabWidgets);
     connect(actionPOIText,               &QAction::changed,              this,      &CMainWindow::slotUpdateTabWidgets);
     connect(actionMapToolTip,            &QAction::changed,              this,      &CMainWindow::slotUpdateTabWidgets);
+    connect(actionRenderStats,           &QAction::toggled,              this,      &CMainWindow::slotRenderStats);
     connect(actionNightDay,              &QAction::changed,              this,      &CMainWindow::slotUpdateTabWidgets);
     connect(actionShowMinMaxTrackLabels, &QAction::changed,              this,      &CMainWindow::slotUpdateTabWidgets);
     connect(actionShowMinMaxSummary,     &QAction::changed,              this,      &CMainWindow::slotUpdateTabWidgets);
@@ -393,6 +395,7 @@ CMainWindow::CMainWindow()
                      << actionPOIText
                      << actionNightDay
                      << actionMapToolTip
+                     << actionRenderStats
                      << actionTrackInfo
                      << actionShowTrackHighlight
                      << actionShowMinMaxSummary
@@ -1236,6 +1239,13 @@ void CMainWindow::slotUpdateTabWidgets()
     }
 }
 
+void CMainWindow::slotRenderStats(bool on)
+{
+    // collect statistics from scratch with a complete redraw
+    CRenderStats::setEnabled(on);
+    slotUpdateTabWidgets();
+}
+
 void CMainWindow::slotSetupMapFont()
 {
     bool ok = false;
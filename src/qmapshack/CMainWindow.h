@@ -171,6 +171,7 @@ private slots:
     void slotCurrentTabDem(int i);
     void slotMousePosition(const QPointF& pos, qreal ele, qreal slope);
     void slotUpdateTabWidgets();
+    void slotRenderStats(bool on);
     void slotSetupMapFont();
     void slotSetupMapBackground();
     void slotSetupGrid();
@@ -0,0 +1,392 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "canvas/CBenchmark.h"
+#include "canvas/CCanvas.h"
+#include "canvas/CRenderStats.h"
+#include "canvas/IDrawContext.h"
+#include "gis/CGisWorkspace.h"
+#include "gis/prj/IGisProject.h"
+#include "gis/qms/CQmsCodec.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <QtWidgets>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+#include <sys/resource.h>
+#endif
+
+CBenchmark::CBenchmark(const QString &filename)
+    : filename(filename)
+{
+}
+
+int CBenchmark::exec()
+{
+    // reject all dialogs as nobody is there to answer them
+    QTimer timerDialogs;
+    QObject::connect(&timerDialogs, &QTimer::timeout, []()
+    {
+        QDialog * dlg = qobject_cast<QDialog*>(QApplication::activeModalWidget());
+        if(dlg != nullptr)
+        {
+            qWarning() << "Reject dialog" << dlg->windowTitle();
+            dlg->reject();
+        }
+    });
+    timerDialogs.start(100);
+
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        std::cerr << tr("Failed to read scenario %1").arg(filename).toUtf8().constData() << std::endl;
+        return 1;
+    }
+
+    QJsonParseError error;
+    scenario = QJsonDocument::fromJson(file.readAll(), &error).object();
+    if(error.error != QJsonParseError::NoError)
+    {
+        std::cerr << tr("Failed to parse scenario %1: %2").arg(filename).arg(error.errorString()).toUtf8().constData() << std::endl;
+        return 1;
+    }
+
+    CCanvas * canvas = new CCanvas(nullptr, "Benchmark");
+    if(!setup(canvas))
+    {
+        delete canvas;
+        return 1;
+    }
+
+    CRenderStats::setEnabled(true);
+
+    const qint64 heap0 = getHeapUsage();
+    QElapsedTimer timer;
+    timer.start();
+
+    // the first frame has to load all data and is not part of the statistics
+    renderFrame(canvas, "");
+    times.clear();
+    timesByStep.clear();
+    CRenderStats::reset();
+
+    for(const QJsonValue& step : scenario["steps"].toArray())
+    {
+        runStep(canvas, step.toObject());
+    }
+
+    const qint64 elapsed = timer.elapsed();
+    const qint64 heap1 = getHeapUsage();
+    const QJsonObject& stats = CRenderStats::getJson();
+
+    delete canvas;
+
+    QJsonObject layers;
+    for(const QString& key : times.keys())
+    {
+        layers[key] = report(times[key]);
+    }
+
+    QJsonArray stepReports;
+    for(const QString& step : steps)
+    {
+        QJsonObject obj = report(timesByStep[step]);
+        obj["name"] = step;
+        stepReports << obj;
+    }
+
+    QJsonObject result;
+    result["scenario"] = scenario["name"].toString(QFileInfo(filename).completeBaseName());
+    result["version"] = QCoreApplication::applicationVersion();
+    result["size"] = QJsonArray({size.width(), size.height()});
+    result["threads"] = QThread::idealThreadCount();
+    result["elapsed"] = elapsed;
+    result["layers"] = layers;
+    result["steps"] = stepReports;
+    result["stats"] = stats;
+    result["codecs"] = benchCodecs();
+    result["heapGrowth"] = (heap0 < 0 || heap1 < 0) ? QJsonValue() : QJsonValue(heap1 - heap0);
+    const qint64 peakRss = getPeakRss();
+    result["peakRss"] = peakRss < 0 ? QJsonValue() : QJsonValue(peakRss);
+
+    std::cout << QJsonDocument(result).toJson(QJsonDocument::Indented).constData() << std::flush;
+    return 0;
+}
+
+bool CBenchmark::setup(CCanvas * canvas)
+{
+    const QDir dir = QFileInfo(filename).absoluteDir();
+    auto path = [dir](const QString& name)
+    {
+        // resources and absolute paths are taken as they are
+        return name.startsWith(":") ? name : dir.absoluteFilePath(name);
+    };
+
+    if(scenario.contains("view"))
+    {
+        const QString& view = path(scenario["view"].toString());
+        if(!QFileInfo(view).isReadable())
+        {
+            std::cerr << tr("Failed to read view %1").arg(view).toUtf8().constData() << std::endl;
+            return false;
+        }
+        QSettings cfg(view, QSettings::IniFormat);
+        canvas->loadConfig(cfg);
+    }
+
+    if(scenario.contains("map"))
+    {
+        canvas->setMap(path(scenario["map"].toString()));
+    }
+
+    QRectF area;
+    for(const QJsonValue& value : scenario["files"].toArray())
+    {
+        const QString& name = path(value.toString());
+        IGisProject * project = CGisWorkspace::self().loadGisProject(name);
+        if(project == nullptr)
+        {
+            std::cerr << tr("Failed to load %1").arg(name).toUtf8().constData() << std::endl;
+            return false;
+        }
+        projects << project;
+
+        for(int i = 0; i < project->childCount(); i++)
+        {
+            IGisItem * item = dynamic_cast<IGisItem*>(project->child(i));
+            if(item != nullptr)
+            {
+                area = area.united(item->getBoundingRect().normalized());
+            }
+        }
+    }
+
+    const QJsonArray& jsonSize = scenario["size"].toArray();
+    if(jsonSize.size() == 2)
+    {
+        size = QSize(jsonSize[0].toInt(), jsonSize[1].toInt());
+    }
+
+    const QJsonArray& jsonArea = scenario["area"].toArray();
+    if(jsonArea.size() == 4)
+    {
+        area = QRectF(QPointF(jsonArea[0].toDouble(), jsonArea[1].toDouble()), QPointF(jsonArea[2].toDouble(), jsonArea[3].toDouble())).normalized();
+        area = QRectF(area.topLeft() * DEG_TO_RAD, area.bottomRight() * DEG_TO_RAD);
+    }
+
+    if(size.isEmpty())
+    {
+        std::cerr << tr("Bad size in scenario %1").arg(filename).toUtf8().constData() << std::endl;
+        return false;
+    }
+
+    if(!area.isEmpty())
+    {
+        canvas->zoomTo(area, size);
+    }
+
+    canvas->setDrawContextSize(size);
+    return true;
+}
+
+void CBenchmark::runStep(CCanvas * canvas, const QJsonObject& step)
+{
+    const QString& name = step["name"].toString(QString("step %1").arg(steps.size() + 1));
+    const int repeat = qMax(1, step["repeat"].toInt(1));
+    steps << name;
+
+    for(int n = 0; n < repeat; n++)
+    {
+        if(step.contains("pan"))
+        {
+            const QJsonArray& delta = step["pan"].toArray();
+            canvas->moveMap(QPointF(delta[0].toDouble(), delta[1].toDouble()));
+        }
+        else if(step.contains("zoom"))
+        {
+            CCanvas::redraw_e needsRedraw = CCanvas::eRedrawNone;
+            canvas->setZoom(step["zoom"].toString() == "in", needsRedraw);
+        }
+        else if(step.contains("focus"))
+        {
+            const QJsonArray& focus = step["focus"].toArray();
+            canvas->posFocus = QPointF(focus[0].toDouble(), focus[1].toDouble()) * DEG_TO_RAD;
+        }
+
+        renderFrame(canvas, name);
+    }
+}
+
+void CBenchmark::renderFrame(CCanvas * canvas, const QString& step)
+{
+    QImage img(size, QImage::Format_ARGB32);
+    img.fill(Qt::transparent);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter p(&img);
+    canvas->printStart(canvas->posFocus);
+    canvas->printFinish(p, size, canvas->posFocus, false);
+    p.end();
+
+    const qreal elapsed = timer.nsecsElapsed() / 1000000.0;
+    times["frame"] << elapsed;
+    timesByStep[step] << elapsed;
+
+    for(const IDrawContext * context : canvas->allDrawContext)
+    {
+        times[context->objectName()] << context->getLastDrawTime();
+    }
+}
+
+QJsonObject CBenchmark::report(const QVector<qreal>& samples) const
+{
+    QJsonObject obj;
+    obj["count"] = samples.size();
+    if(samples.isEmpty())
+    {
+        return obj;
+    }
+
+    QVector<qreal> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    // percentile by nearest rank
+    auto percentile = [&sorted](qreal p)
+    {
+        const int idx = qCeil(p / 100.0 * sorted.size()) - 1;
+        return sorted[qBound(0, idx, sorted.size() - 1)];
+    };
+
+    obj["mean"] = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    obj["p50"] = percentile(50);
+    obj["p90"] = percentile(90);
+    obj["p99"] = percentile(99);
+    obj["max"] = sorted.last();
+    return obj;
+}
+
+QJsonObject CBenchmark::benchCodecs() const
+{
+    // the items serialized without compression are the input for all codecs
+    const CQmsCodec::codec_e codec = CQmsCodec::getCodec();
+    CQmsCodec::setCodec(CQmsCodec::eCodecNone);
+
+    QList<QByteArray> inputs;
+    qint64 sizeInput = 0;
+    for(const IGisProject * project : projects)
+    {
+        for(int i = 0; i < project->childCount(); i++)
+        {
+            const IGisItem * item = dynamic_cast<const IGisItem*>(project->child(i));
+            if(item == nullptr)
+            {
+                continue;
+            }
+
+            QByteArray data;
+            QDataStream stream(&data, QIODevice::WriteOnly);
+            stream.setByteOrder(QDataStream::LittleEndian);
+            stream.setVersion(QDataStream::Qt_5_2);
+            *item >> stream;
+
+            inputs << data;
+            sizeInput += data.size();
+        }
+    }
+    CQmsCodec::setCodec(codec);
+
+    QJsonObject result;
+    if(inputs.isEmpty())
+    {
+        return result;
+    }
+
+    // untranslated names as keys for the report
+    const char * names[CQmsCodec::eCodecCount] = {"zlib best", "zlib fast", "none"};
+    for(int c = 0; c < CQmsCodec::eCodecCount; c++)
+    {
+        QElapsedTimer timer;
+        QList<QByteArray> outputs;
+        qint64 sizeOutput = 0;
+
+        timer.start();
+        for(const QByteArray& data : inputs)
+        {
+            outputs << CQmsCodec::compress(data, CQmsCodec::codec_e(c));
+            sizeOutput += outputs.last().size();
+        }
+        const qreal timeSave = qMax(timer.nsecsElapsed(), qint64(1)) / 1e9;
+
+        timer.restart();
+        for(const QByteArray& data : outputs)
+        {
+            CQmsCodec::uncompress(data);
+        }
+        const qreal timeLoad = qMax(timer.nsecsElapsed(), qint64(1)) / 1e9;
+
+        QJsonObject obj;
+        obj["bytes"] = sizeOutput;
+        obj["ratio"] = qreal(sizeOutput) / sizeInput;
+        obj["saveMBps"] = sizeInput / timeSave / 1e6;
+        obj["loadMBps"] = sizeInput / timeLoad / 1e6;
+        result[names[c]] = obj;
+    }
+
+    result["input"] = sizeInput;
+    return result;
+}
+
+qint64 CBenchmark::getHeapUsage()
+{
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#else
+    return quint32(mallinfo().uordblks);
+#endif
+#else
+    return -1;
+#endif
+}
+
+qint64 CBenchmark::getPeakRss()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+#if defined(Q_OS_MAC)
+    // macOS reports bytes
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,98 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CBENCHMARK_H
+#define CBENCHMARK_H
+
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QMap>
+#include <QVector>
+
+class CCanvas;
+class IGisProject;
+
+/**
+   @brief Replay a scripted sequence of pans and zooms and measure the render times
+
+   Used by the command line option --bench and the build target qmsbench. The
+   scenario is a JSON file:
+
+        {
+            "name": "World",
+            "view": "my.view",          // maps, DEM, projection and scale (optional)
+            "map": "://map/World.gemf", // or a single map file (optional)
+            "files": ["track.gpx"],     // loaded as overlays (optional)
+            "area": [lon1, lat1, lon2, lat2],
+            "size": [1024, 768],
+            "steps": [
+                {"name": "pan east", "pan": [-200, 0], "repeat": 10},
+                {"name": "zoom in", "zoom": "in", "repeat": 5},
+                {"name": "jump", "focus": [lon, lat]}
+            ]
+        }
+
+   Pans are in [px], positions in [°]. Relative paths are relative to the
+   scenario file. Each step is rendered by the same draw contexts as used on
+   screen. The times of each layer's render thread and of the complete frame
+   are reported as JSON on stdout.
+
+   Additionally the items of the loaded files are used to measure the
+   throughput of each codec used to save items (see CQmsCodec).
+ */
+class CBenchmark
+{
+    Q_DECLARE_TR_FUNCTIONS(CBenchmark)
+public:
+    CBenchmark(const QString& filename);
+    virtual ~CBenchmark() = default;
+
+    /**
+       @brief Run the scenario and print the report
+
+       @return The exit code of the application
+     */
+    int exec();
+
+private:
+    bool setup(CCanvas * canvas);
+    void runStep(CCanvas * canvas, const QJsonObject& step);
+    void renderFrame(CCanvas * canvas, const QString& step);
+    QJsonObject report(const QVector<qreal>& samples) const;
+    /// measure compression and decompression of all loaded items by each codec
+    QJsonObject benchCodecs() const;
+
+    /// get the number of bytes allocated on the heap or -1 if unknown
+    static qint64 getHeapUsage();
+    /// get the peak resident set size in [kB] or -1 if unknown
+    static qint64 getPeakRss();
+
+    QString filename;
+    QJsonObject scenario;
+    QSize size {1024, 768};
+    /// the projects loaded from the scenario's files
+    QList<IGisProject*> projects;
+
+    /// the frame times in [ms] by layer, "frame" is the complete frame
+    QMap<QString, QVector<qreal> > times;
+    /// the frame times in [ms] by step
+    QMap<QString, QVector<qreal> > timesByStep;
+    QStringList steps;
+};
+
+#endif //CBENCHMARK_H
@@ -19,6 +19,7 @@
 
 #include "canvas/CCanvas.h"
 #include "canvas/CCanvasSetup.h"
+#include "canvas/CRenderStats.h"
 #include "CMainWindow.h"
 #include "dem/CDemDraw.h"
 #include "gis/CGisDraw.h"
@@ -65,6 +66,9 @@ qreal CCanvas::gisLayerOpacity          = 1.0;
 #define WIDTH_PROFILE_SMALL   200
 #define HEIGHT_PROFILE_SMALL  80
 
+#define PRINT_TILE_SIZE       1024
+#define PRINT_TILE_MARGIN     128
+
 inline QSize getTrackProfileSize(int height)
 {
     return height > 700 ?
@@ -621,6 +625,7 @@ void CCanvas::paintEvent(QPaintEvent*)
 
     drawStatusMessages(p);
     drawTrackStatistic(p);
+    drawRenderStats(p);
 
     p.end();
     needsRedraw = eRedrawNone;
@@ -796,6 +801,32 @@ void CCanvas::drawStatusMessages(QPainter& p)
     }
 }
 
+void CCanvas::drawRenderStats(QPainter& p)
+{
+    if(!CRenderStats::isEnabled())
+    {
+        return;
+    }
+
+    const QString& report = CRenderStats::getReport(objectName() + "/");
+
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPointSize(8);
+
+    p.save();
+    p.setFont(font);
+    QRect r = p.fontMetrics().boundingRect(rect(), Qt::AlignLeft | Qt::AlignTop, report);
+    r.moveTopRight(QPoint(width() - 10, 10));
+
+    p.setPen(CDraw::penBorderGray);
+    p.setBrush(QColor(255, 255, 255, 200));
+    p.drawRoundedRect(r.adjusted(-5, -5, 5, 5), RECT_RADIUS, RECT_RADIUS);
+    p.setPen(Qt::black);
+    p.drawText(r, Qt::AlignLeft | Qt::AlignTop, report);
+    p.restore();
+}
+
 void CCanvas::drawTrackStatistic(QPainter& p)
 {
     p.save();
@@ -883,6 +914,11 @@ void CCanvas::drawScale(QPainter& p, QRectF drawRect)
 
 void CCanvas::slotTriggerCompleteUpdate(CCanvas::redraw_e flags)
 {
+    for(IDrawContext * context : allDrawContext)
+    {
+        context->invalidate(flags);
+    }
+
     needsRedraw = (redraw_e)(needsRedraw | flags);
     update();
 }
@@ -1037,7 +1073,9 @@ void CCanvas::moveMap(const QPointF& delta)
 
     emit sigMove();
 
-    slotTriggerCompleteUpdate(eRedrawAll);
+    // the content has not changed, the draw contexts can reuse what is still visible
+    needsRedraw = eRedrawAll;
+    update();
 }
 
 void CCanvas::zoomTo(const QRectF& rect)
@@ -1052,6 +1090,13 @@ void CCanvas::zoomTo(const QRectF& rect)
     slotTriggerCompleteUpdate(eRedrawAll);
 }
 
+void CCanvas::zoomTo(const QRectF& rect, const QSize& size)
+{
+    setDrawContextSize(size);
+    zoomTo(rect);
+    setDrawContextSize(this->size());
+}
+
 void CCanvas::setupGrid()
 {
     CGridSetup dlg(grid, map);
@@ -1273,32 +1318,48 @@ void CCanvas::print(QPainter& p, const QRectF& area, const QPointF& focus, bool
 
     setDrawContextSize(newSize);
 
-    // ----- start to draw thread based content -----
-    // move coordinate system to center of the screen
-    p.translate(newSize.width() >> 1, newSize.height() >> 1);
+    printStart(focus);
+    printFinish(p, newSize, focus, printScale);
 
-    redraw_e redraw = eRedrawAll;
+    setDrawContextSize(oldSize);
+}
+
+void CCanvas::printStart(const QPointF& focus)
+{
+    // the painter is just needed to trigger the draw threads
+    QImage img(1, 1, QImage::Format_ARGB32);
+    QPainter p(&img);
 
     for(IDrawContext * context : allDrawContext)
     {
-        context->draw(p, redraw, focus);
+        // a print needs the full detail only
+        context->setPreviewEnabled(false);
+        context->draw(p, eRedrawAll, focus);
     }
+}
 
+void CCanvas::printFinish(QPainter& p, const QSize& size, const QPointF& focus, bool printScale)
+{
     for(IDrawContext * context : allDrawContext)
     {
         context->wait();
+        context->setPreviewEnabled(true);
     }
 
+    // ----- start to draw thread based content -----
+    // move coordinate system to center of the screen
+    p.translate(size.width() >> 1, size.height() >> 1);
+
     for(IDrawContext * context : allDrawContext)
     {
-        context->draw(p, redraw, focus);
+        context->draw(p, eRedrawNone, focus);
     }
 
     // restore coordinate system to default
     p.resetTransform();
     // ----- start to draw fast content -----
 
-    QRect r(QPoint(0, 0), area.size().toSize());
+    QRect r(QPoint(0, 0), size);
 
     grid->draw(p, r);
     gis->draw(p, r);
@@ -1307,8 +1368,112 @@ void CCanvas::print(QPainter& p, const QRectF& area, const QPointF& focus, bool
     {
         drawScale(p, r);
     }
+}
 
-    setDrawContextSize(oldSize);
+bool CCanvas::printTiles(const QSize& size, const QPointF& focus, bool printScale, const fPrintTileSink& sink)
+{
+    return printTiles({this}, size, focus, printScale, sink);
+}
+
+bool CCanvas::printTiles(const QList<CCanvas*>& canvases, const QSize& size, const QPointF& focus, bool printScale, const fPrintTileSink& sink)
+{
+    const int T = PRINT_TILE_SIZE;
+    const int M = PRINT_TILE_MARGIN;
+    // all tiles are rendered with the same size and a margin. Labels close to the
+    // tile's border are placed as if the whole area is drawn at once.
+    const QSize sizeTile(T + 2 * M, T + 2 * M);
+
+    if(canvases.isEmpty())
+    {
+        return false;
+    }
+
+    // The tile centers have to be calculated before the first tile is drawn.
+    // Drawing a tile will change the draw context's coordinate system.
+    CCanvas * first = canvases.first();
+    QPointF pxFocus = focus;
+    first->convertRad2Px(pxFocus);
+    const QPointF pxOffset = pxFocus - QPointF(size.width(), size.height()) / 2;
+
+    QList<QRect> tiles;
+    QList<QPointF> centers;
+    for(int y = 0; y < size.height(); y += T)
+    {
+        for(int x = 0; x < size.width(); x += T)
+        {
+            QPointF center = QPointF(x + T / 2, y + T / 2) + pxOffset;
+            first->convertPx2Rad(center);
+
+            tiles << QRect(x, y, qMin(T, size.width() - x), qMin(T, size.height() - y));
+            centers << center;
+        }
+    }
+
+    QList<QSize> oldSizes;
+    for(CCanvas * canvas : canvases)
+    {
+        oldSizes << canvas->size();
+        canvas->setDrawContextSize(sizeTile);
+    }
+
+    // Each canvas renders a tile in the background. Thus with several
+    // canvases several tiles are rendered in parallel.
+    const int N = canvases.size();
+    bool success = true;
+    for(int n = 0; success && (n < tiles.size()); n += N)
+    {
+        const int cnt = qMin(N, tiles.size() - n);
+        for(int i = 0; i < cnt; i++)
+        {
+            canvases[i]->printStart(centers[n + i]);
+        }
+
+        for(int i = 0; i < cnt; i++)
+        {
+            const QRect& tile = tiles[n + i];
+
+            QImage img(sizeTile, QImage::Format_ARGB32_Premultiplied);
+            img.fill(Qt::transparent);
+
+            QPainter p(&img);
+            USE_ANTI_ALIASING(p, true);
+            canvases[i]->printFinish(p, sizeTile, centers[n + i], false);
+
+            if(printScale)
+            {
+                // the scale is drawn in the coordinate system of the tile
+                // into the bottom right corner of the complete area
+                canvases[i]->drawScale(p, QRectF(QPointF(M, M) - tile.topLeft(), size));
+            }
+            p.end();
+
+            if(success && !sink(img.copy(QRect(QPoint(M, M), tile.size())), tile.topLeft()))
+            {
+                success = false;
+            }
+        }
+    }
+
+    for(int i = 0; i < N; i++)
+    {
+        for(IDrawContext * context : canvases[i]->allDrawContext)
+        {
+            context->wait();
+        }
+        canvases[i]->setDrawContextSize(oldSizes[i]);
+    }
+
+    return success;
+}
+
+void CCanvas::printTiled(QPainter& p, const QRectF& area, const QPointF& focus, bool printScale)
+{
+    const QPointF& offset = area.topLeft();
+    printTiles(area.size().toSize(), focus, printScale, [&p, offset](const QImage& img, const QPoint& pos)
+    {
+        p.drawImage(offset + pos, img);
+        return true;
+    });
 }
 
 bool CCanvas::event(QEvent *event)
@@ -20,6 +20,7 @@
 #ifndef CCANVAS_H
 #define CCANVAS_H
 
+#include <functional>
 #include <proj_api.h>
 #include <QMap>
 #include <QPainter>
@@ -56,6 +57,7 @@ class CTableTrkInfo;
 class CCanvas : public QWidget
 {
     Q_OBJECT
+    friend class CBenchmark;
 public:
     CCanvas(QWidget * parent, const QString& name);
     virtual ~CCanvas();
@@ -97,6 +99,15 @@ public:
 
     void moveMap(const QPointF &delta);
     void zoomTo(const QRectF& rect);
+    /**
+       @brief Zoom to the largest scale showing an area within a given size
+
+       Used to render an area without a visible canvas.
+
+       @param rect  the area in [rad]
+       @param size  the size in [px]
+     */
+    void zoomTo(const QRectF& rect, const QSize& size);
     void displayInfo(const QPoint& px);
     poi_t findPOICloseBy(const QPoint& px) const;
 
@@ -164,6 +175,34 @@ public:
 
     void print(QPainter &p, const QRectF& area, const QPointF &focus, bool printScale = true);
 
+    using fPrintTileSink = std::function<bool(const QImage& img, const QPoint& pos)>;
+
+    /**
+       @brief Render an area tile by tile
+
+       Instead of buffers of the area's size, only buffers of a single tile's size
+       are allocated. Thus the memory used does not depend on the size of the area.
+
+       @param size          the area's size in [px]
+       @param focus         the area's center in [rad]
+       @param printScale    draw the scale into the bottom right corner of the area
+       @param sink          called for each tile with the tile's image and its offset
+                            in the area. Return false to abort.
+       @return False if the sink aborted.
+     */
+    bool printTiles(const QSize& size, const QPointF& focus, bool printScale, const fPrintTileSink& sink);
+
+    /**
+       @brief Same as above but the tiles are distributed over several canvases
+
+       As each canvas draws in its own threads the tiles are rendered in parallel.
+       All canvases must show the same view.
+     */
+    static bool printTiles(const QList<CCanvas*>& canvases, const QSize& size, const QPointF& focus, bool printScale, const fPrintTileSink& sink);
+
+    /// same as print() but renders the area tile by tile with bounded memory
+    void printTiled(QPainter& p, const QRectF& area, const QPointF& focus, bool printScale = true);
+
     /**
        @brief Set a single map file to be shown on the canvas
 
@@ -216,11 +255,17 @@ private slots:
 private:
     void drawStatusMessages(QPainter& p);
     void drawTrackStatistic(QPainter& p);
+    /// draw the render times and counters collected by CRenderStats
+    void drawRenderStats(QPainter& p);
     void drawScale(QPainter& p, QRectF drawRect);
     void drawScale(QPainter& p)//Default use, drawRect is introduced for correct printing
     {
         drawScale(p, rect());
     }
+    /// start to draw the threaded content for printing
+    void printStart(const QPointF& focus);
+    /// wait for the threads started by printStart() and draw everything into the painter
+    void printFinish(QPainter& p, const QSize& size, const QPointF& focus, bool printScale);
     void setZoom(bool in, redraw_e & needsRedraw);
     void setSizeTrackProfile();
     /**
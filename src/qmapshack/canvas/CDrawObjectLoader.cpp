@@ -0,0 +1,59 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "canvas/CDrawObjectLoader.h"
+#include "canvas/IDrawObject.h"
+
+#include <QtCore>
+
+CDrawObjectLoader::CDrawObjectLoader(const factory_t &factory)
+    : QThread(nullptr)
+    , factory(factory)
+{
+}
+
+CDrawObjectLoader::~CDrawObjectLoader()
+{
+    delete object;
+}
+
+void CDrawObjectLoader::load()
+{
+    // connect last to let all other receivers of finished() see the loader first
+    connect(this, &CDrawObjectLoader::finished, this, &CDrawObjectLoader::deleteLater);
+    start();
+}
+
+IDrawObject * CDrawObjectLoader::takeObject()
+{
+    IDrawObject * obj = object;
+    object = nullptr;
+    return obj;
+}
+
+void CDrawObjectLoader::run()
+{
+    object = factory();
+    if(object != nullptr)
+    {
+        // the object has been created in this thread. Pass it to
+        // the thread of the loader, which is the GUI thread.
+        object->moveToThread(thread());
+    }
+}
+
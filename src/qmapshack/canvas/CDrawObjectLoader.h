@@ -0,0 +1,72 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CDRAWOBJECTLOADER_H
+#define CDRAWOBJECTLOADER_H
+
+#include <functional>
+#include <QThread>
+
+class IDrawObject;
+
+/**
+   @brief Create a draw object (map, DEM) in a worker thread
+
+   Opening some map formats takes quite some time. To keep the GUI responsive the
+   object is created by the factory function in a worker thread. When done the
+   object is moved to the GUI thread and the thread's finished() signal is emitted.
+   The receiver has to call takeObject() to get the object.
+
+   Connect to finished() before calling load(). The loader deletes itself after it
+   has finished. If nobody has taken the object it will be deleted together with
+   the loader.
+
+   @note The factory must not access any GUI objects. The created object has no
+         QObject parent. The receiver has to set one.
+ */
+class CDrawObjectLoader : public QThread
+{
+    Q_OBJECT
+public:
+    using factory_t = std::function<IDrawObject*()>;
+
+    CDrawObjectLoader(const factory_t& factory);
+    virtual ~CDrawObjectLoader();
+
+    /// start the worker thread
+    void load();
+
+    /**
+       @brief Take ownership of the loaded object
+
+       Call this from the GUI thread after finished() has been emitted.
+
+       @return The loaded object or nullptr if the factory failed.
+     */
+    IDrawObject * takeObject();
+
+protected:
+    void run() override;
+
+private:
+    factory_t factory;
+    IDrawObject * object = nullptr;
+};
+
+#endif //CDRAWOBJECTLOADER_H
+
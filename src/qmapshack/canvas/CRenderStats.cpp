@@ -0,0 +1,148 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "canvas/CRenderStats.h"
+
+#include <QtCore>
+
+QAtomicInt CRenderStats::enabled(0);
+QMutex CRenderStats::mutex;
+QMap<QString, CRenderStats::timing_t> CRenderStats::timings;
+QMap<QString, quint64> CRenderStats::counters;
+QMap<QString, qint64> CRenderStats::values;
+
+void CRenderStats::setEnabled(bool yes)
+{
+    if(yes && !isEnabled())
+    {
+        reset();
+    }
+    enabled.store(yes ? 1 : 0);
+}
+
+void CRenderStats::addTiming(const QString& key, qreal ms)
+{
+    if(!isEnabled())
+    {
+        return;
+    }
+
+    QMutexLocker lock(&mutex);
+    timing_t& timing = timings[key];
+    timing.count++;
+    timing.last = ms;
+    timing.sum += ms;
+    timing.max = qMax(timing.max, ms);
+}
+
+void CRenderStats::addCount(const QString& key, quint32 n)
+{
+    if(!isEnabled())
+    {
+        return;
+    }
+
+    QMutexLocker lock(&mutex);
+    counters[key] += n;
+}
+
+void CRenderStats::setValue(const QString& key, qint64 value)
+{
+    if(!isEnabled())
+    {
+        return;
+    }
+
+    QMutexLocker lock(&mutex);
+    values[key] = value;
+}
+
+void CRenderStats::reset()
+{
+    QMutexLocker lock(&mutex);
+    timings.clear();
+    counters.clear();
+    values.clear();
+}
+
+QString CRenderStats::getReport(const QString& prefix)
+{
+    QMutexLocker lock(&mutex);
+
+    QString report = QString("%1 %2\n").arg(tr("Layer"), -32).arg(tr("last / mean / max [ms]"));
+    for(const QString& key : timings.keys())
+    {
+        if(!key.startsWith(prefix))
+        {
+            continue;
+        }
+
+        const timing_t& timing = timings[key];
+        report += QString("%1 %2 / %3 / %4\n")
+                  .arg(key.mid(prefix.size()), -32)
+                  .arg(timing.last, 0, 'f', 1)
+                  .arg(timing.sum / timing.count, 0, 'f', 1)
+                  .arg(timing.max, 0, 'f', 1);
+    }
+
+    for(const QString& key : counters.keys())
+    {
+        report += QString("%1 %2\n").arg(key, -32).arg(counters[key]);
+    }
+
+    for(const QString& key : values.keys())
+    {
+        report += QString("%1 %2\n").arg(key, -32).arg(values[key]);
+    }
+
+    return report.trimmed();
+}
+
+QJsonObject CRenderStats::getJson()
+{
+    QMutexLocker lock(&mutex);
+
+    QJsonObject jsonTimings;
+    for(const QString& key : timings.keys())
+    {
+        const timing_t& timing = timings[key];
+        QJsonObject obj;
+        obj["count"] = qint64(timing.count);
+        obj["mean"] = timing.sum / timing.count;
+        obj["max"] = timing.max;
+        jsonTimings[key] = obj;
+    }
+
+    QJsonObject jsonCounters;
+    for(const QString& key : counters.keys())
+    {
+        jsonCounters[key] = qint64(counters[key]);
+    }
+
+    QJsonObject jsonValues;
+    for(const QString& key : values.keys())
+    {
+        jsonValues[key] = values[key];
+    }
+
+    QJsonObject json;
+    json["timings"] = jsonTimings;
+    json["counters"] = jsonCounters;
+    json["values"] = jsonValues;
+    return json;
+}
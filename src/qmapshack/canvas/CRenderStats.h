@@ -0,0 +1,80 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CRENDERSTATS_H
+#define CRENDERSTATS_H
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+
+/**
+   @brief Collect render times and counters of the draw contexts, maps and DEMs
+
+   All methods are thread safe and can be called from the render threads. As
+   long as the statistics are disabled the methods return immediately. The keys
+   are paths like "View 1/map/OpenStreetMap" or "tile cache/OSM/miss".
+ */
+class CRenderStats
+{
+    Q_DECLARE_TR_FUNCTIONS(CRenderStats)
+public:
+    struct timing_t
+    {
+        quint32 count = 0; //< the number of samples
+        qreal last = 0;    //< the last sample in [ms]
+        qreal sum = 0;     //< the sum of all samples in [ms]
+        qreal max = 0;     //< the largest sample in [ms]
+    };
+
+    static void setEnabled(bool yes);
+    static bool isEnabled()
+    {
+        return enabled.load() != 0;
+    }
+
+    /// add a time in [ms] to the statistic of the key
+    static void addTiming(const QString& key, qreal ms);
+    /// increment the counter of the key
+    static void addCount(const QString& key, quint32 n = 1);
+    /// set the current value of the key, e.g. a queue length
+    static void setValue(const QString& key, qint64 value);
+    /// clear all statistics
+    static void reset();
+
+    /**
+       @brief Get a text table of the statistics for the canvas HUD
+
+       @param prefix    only timings with keys starting with the prefix are listed.
+                        Counters and values are always listed.
+     */
+    static QString getReport(const QString& prefix);
+    /// get all statistics as JSON object
+    static QJsonObject getJson();
+
+private:
+    static QAtomicInt enabled;
+    static QMutex mutex;
+    static QMap<QString, timing_t> timings;
+    static QMap<QString, quint64> counters;
+    static QMap<QString, qint64> values;
+};
+
+#endif //CRENDERSTATS_H
@@ -16,12 +16,15 @@
 
 **********************************************************************************************/
 
+#include "canvas/CRenderStats.h"
 #include "canvas/IDrawContext.h"
 
 #include <QtWidgets>
 
 
 #define BUFFER_BORDER 50
+/// layers that took longer than this [ms] to render draw a preview first
+#define PREVIEW_THRESHOLD 150
 
 
 #define N_DEFAULT_ZOOM_LEVELS 31
@@ -72,6 +75,7 @@ IDrawContext::IDrawContext(const QString& name, CCanvas::redraw_e maskRedraw, CC
     resize(canvas->size());
     connect(this, &IDrawContext::finished, canvas, static_cast<void (CCanvas::*)()>(&CCanvas::update));
     connect(this, &IDrawContext::finished, this,   &IDrawContext::sigStopThread);
+    connect(this, &IDrawContext::sigPreview, canvas, static_cast<void (CCanvas::*)()>(&CCanvas::update));
 }
 
 IDrawContext::~IDrawContext()
@@ -85,6 +89,15 @@ void IDrawContext::emitSigCanvasUpdate()
     emit sigCanvasUpdate(maskRedraw);
 }
 
+void IDrawContext::invalidate(CCanvas::redraw_e flags)
+{
+    if(flags & maskRedraw)
+    {
+        QMutexLocker lock(&mutex);
+        contentVersion++;
+    }
+}
+
 
 bool IDrawContext::resize(const QSize& size)
 {
@@ -116,6 +129,10 @@ bool IDrawContext::resize(const QSize& size)
     buffer[1].image = QImage(bufWidth, bufHeight, QImage::Format_ARGB32);
     buffer[1].image.fill(Qt::transparent);
 
+    // the blank buffers must not be reused by the next pass
+    buffer[0].complete = false;
+    buffer[1].complete = false;
+
     return true;
 }
 
@@ -473,39 +490,180 @@ void IDrawContext::draw(QPainter& p, CCanvas::redraw_e needsRedraw, const QPoint
 void IDrawContext::run()
 {
     mutex.lock();
-    QTime t;
+    QElapsedTimer t;
     t.start();
-//    qDebug() << "start thread" << objectName();
+    // each pass but the last one has been aborted by a new redraw request
+    int passes = 0;
 
-    IDrawContext::buffer_t& currentBuffer = buffer[!bufIndex];
     while(intNeedsRedraw)
     {
+        passes++;
+        IDrawContext::buffer_t * currentBuffer = &buffer[!bufIndex];
         // copy all projection information need by the
         // map render objects to buffer structure
-        currentBuffer.pjsrc      = pjsrc;
-        currentBuffer.zoomFactor = zoomFactor;
-        currentBuffer.scale      = scale;
-        currentBuffer.ref1       = ref1;
-        currentBuffer.ref2       = ref2;
-        currentBuffer.ref3       = ref3;
-        currentBuffer.ref4       = ref4;
-        currentBuffer.focus      = focus;
-        intNeedsRedraw           = false;
+        currentBuffer->pjsrc      = pjsrc;
+        currentBuffer->zoomFactor = zoomFactor;
+        currentBuffer->scale      = scale;
+        currentBuffer->ref1       = ref1;
+        currentBuffer->ref2       = ref2;
+        currentBuffer->ref3       = ref3;
+        currentBuffer->ref4       = ref4;
+        currentBuffer->focus      = focus;
+        currentBuffer->version    = contentVersion;
+        currentBuffer->complete   = false;
+        intNeedsRedraw            = false;
+
+        // if just the focus has moved the last buffer can be reused
+        const IDrawContext::buffer_t& lastBuffer = buffer[bufIndex];
+        const bool reuse = canReuseBuffer() && lastBuffer.complete
+                           && (lastBuffer.version == contentVersion)
+                           && (lastBuffer.pjsrc == pjsrc)
+                           && (lastBuffer.scale == scale)
+                           && (lastBuffer.zoomFactor == zoomFactor)
+                           && (lastBuffer.image.size() == currentBuffer->image.size());
+
+        // slow layers show a quick preview before they render the full detail
+        const bool preview = !reuse && previewEnabled && hasPreview() && (lastPassTime > PREVIEW_THRESHOLD);
 
         mutex.unlock();
 
-//        qDebug() << "bufferScale" << (currentBuffer.scale * currentBuffer.zoomFactor);
+        if(reuse && drawReused(*currentBuffer, lastBuffer))
+        {
+            mutex.lock();
+            currentBuffer->complete = !intNeedsRedraw;
+            continue;
+        }
+
+        if(preview)
+        {
+            currentBuffer->preview = true;
+            currentBuffer->image.fill(Qt::transparent);
+            drawt(*currentBuffer);
+            currentBuffer->preview = false;
+
+            mutex.lock();
+            if(intNeedsRedraw)
+            {
+                // new input, start over
+                continue;
+            }
+
+            // show the preview and render the full detail into the other buffer
+            bufIndex = !bufIndex;
+            IDrawContext::buffer_t * previewBuffer = currentBuffer;
+            currentBuffer = &buffer[!bufIndex];
+            currentBuffer->pjsrc      = previewBuffer->pjsrc;
+            currentBuffer->zoomFactor = previewBuffer->zoomFactor;
+            currentBuffer->scale      = previewBuffer->scale;
+            currentBuffer->ref1       = previewBuffer->ref1;
+            currentBuffer->ref2       = previewBuffer->ref2;
+            currentBuffer->ref3       = previewBuffer->ref3;
+            currentBuffer->ref4       = previewBuffer->ref4;
+            currentBuffer->focus      = previewBuffer->focus;
+            currentBuffer->version    = previewBuffer->version;
+            mutex.unlock();
+
+            emit sigPreview();
+        }
+
+        QElapsedTimer tPass;
+        tPass.start();
+
         // ----- reset buffer -----
-        currentBuffer.image.fill(Qt::transparent);
+        currentBuffer->image.fill(Qt::transparent);
 
-        drawt(currentBuffer);
+        drawt(*currentBuffer);
 
         mutex.lock();
+        if(!intNeedsRedraw)
+        {
+            lastPassTime = tPass.nsecsElapsed() / 1000000.0;
+            currentBuffer->complete = true;
+        }
     }
     // ----- switch buffer ------
     bufIndex = !bufIndex;
-//    qDebug() << "stop thread" << objectName() << "after" << t.elapsed() << "ms";
+    lastDrawTime = t.nsecsElapsed() / 1000000.0;
 
     mutex.unlock();
+
+    if(CRenderStats::isEnabled())
+    {
+        const QString& key = canvas->objectName() + "/" + objectName();
+        CRenderStats::addTiming(key, lastDrawTime);
+        if(passes > 1)
+        {
+            CRenderStats::addCount(key + "/aborted", passes - 1);
+        }
+        qDebug() << "render" << key << "after" << lastDrawTime << "ms with" << (passes - 1) << "aborted passes";
+    }
 }
 
+bool IDrawContext::drawReused(buffer_t& buf, const buffer_t& last)
+{
+    // the strips can't be converted correctly if the buffer crosses the date line
+    if(buf.ref1.x() < -180 * DEG_TO_RAD || buf.ref2.x() > 180 * DEG_TO_RAD)
+    {
+        return false;
+    }
+
+    const QPointF bufferScale = buf.scale * buf.zoomFactor;
+
+    QPointF ref     = buf.ref1;
+    QPointF refLast = last.ref1;
+    convertRad2M(ref);
+    convertRad2M(refLast);
+
+    // the offset of the last buffer has to be a full pixel to copy it without blur
+    const QPointF off   = (refLast - ref) / bufferScale;
+    const QPoint offPx  = off.toPoint();
+    if((off - offPx).manhattanLength() > 0.1)
+    {
+        return false;
+    }
+
+    const QRect rectBuffer = buf.image.rect();
+    const QRect rectReused = rectBuffer.intersected(last.image.rect().translated(offPx));
+    if(rectReused.isEmpty())
+    {
+        return false;
+    }
+
+    buf.image.fill(Qt::transparent);
+    QPainter p(&buf.image);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.drawImage(offPx, last.image);
+
+    const QRegion exposed = QRegion(rectBuffer).subtracted(rectReused);
+    for(const QRect& rect : exposed.rects())
+    {
+        if(needsRedraw())
+        {
+            break;
+        }
+
+        buffer_t strip;
+        strip.pjsrc      = buf.pjsrc;
+        strip.zoomFactor = buf.zoomFactor;
+        strip.scale      = buf.scale;
+        strip.focus      = buf.focus;
+        strip.image      = QImage(rect.size(), QImage::Format_ARGB32);
+        strip.image.fill(Qt::transparent);
+
+        // corners of the strip in [rad]
+        strip.ref1 = ref + QPointF(rect.left(), rect.top()) * bufferScale;
+        strip.ref2 = ref + QPointF(rect.right() + 1, rect.top()) * bufferScale;
+        strip.ref3 = ref + QPointF(rect.right() + 1, rect.bottom() + 1) * bufferScale;
+        strip.ref4 = ref + QPointF(rect.left(), rect.bottom() + 1) * bufferScale;
+        convertM2Rad(strip.ref1);
+        convertM2Rad(strip.ref2);
+        convertM2Rad(strip.ref3);
+        convertM2Rad(strip.ref4);
+
+        drawt(strip);
+
+        p.drawImage(rect.topLeft(), strip.image);
+    }
+
+    return true;
+}
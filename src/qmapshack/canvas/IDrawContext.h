@@ -55,6 +55,11 @@ public:
         QPointF ref3;  //< bottom right corner
         QPointF ref4;  //< bottom left corner
         QPointF focus; //< point of focus
+
+        bool preview = false; //< draw a quick pass with less detail
+
+        bool complete = false; //< the buffer holds a complete pass with full detail
+        quint32 version = 0;   //< the content version the buffer was drawn with
     };
 
     /**
@@ -106,6 +111,32 @@ public:
      */
     bool needsRedraw() const;
 
+    /// get the time in [ms] the last render pass of the thread took
+    qreal getLastDrawTime() const
+    {
+        return lastDrawTime;
+    }
+
+    /**
+       @brief Tell the draw context that the content has changed
+
+       A buffer drawn before can't be reused for the next pass anymore. Moving the
+       point of focus doesn't need to call this.
+
+       @param flags     the layers that have changed
+     */
+    void invalidate(CCanvas::redraw_e flags);
+
+    /**
+       @brief Enable or disable the preview pass of slow layers
+
+       The preview is useful on screen only. Disable it while printing.
+     */
+    void setPreviewEnabled(bool yes)
+    {
+        previewEnabled = yes;
+    }
+
     /**
         @brief Draw the active map buffer to the painter
         @param p            the painter used to draw the map
@@ -150,6 +181,8 @@ signals:
     void sigCanvasUpdate(CCanvas::redraw_e flags);
     void sigStartThread();
     void sigStopThread();
+    /// the thread has finished the preview and continues with the full detail
+    void sigPreview();
     void sigScaleChanged(const QPointF& scale);
 
 public slots:
@@ -166,6 +199,35 @@ protected:
      */
     virtual void drawt(buffer_t& currentBuffer) = 0;
 
+    /**
+       @brief Tell if drawt() can draw a quick preview with less detail
+
+       If the last render pass took too long drawt() is called twice. First with
+       buffer_t::preview set to show something as soon as possible. Second to
+       draw the full detail. The preview is shown in the meantime.
+
+       @return Return true if the context draws faster with buffer_t::preview set.
+     */
+    virtual bool hasPreview() const
+    {
+        return false;
+    }
+
+    /**
+       @brief Tell if drawt() can draw parts of the buffer without seams
+
+       If just the point of focus has moved, the part of the last buffer still
+       visible is copied and drawt() is called for the uncovered strips only. This
+       is not possible if the rendering depends on the buffer's extent, e.g. for
+       the placement of labels.
+
+       @return Return true if the last buffer can be reused when panning.
+     */
+    virtual bool canReuseBuffer() const
+    {
+        return false;
+    }
+
     /**
        @brief The global list of available scale factors
      */
@@ -221,6 +283,21 @@ private:
     QPointF ref2; //< top right corner of next buffer
     QPointF ref3; //< bottom right corner of next buffer
     QPointF ref4; //< bottom left corner of next buffer
+
+    qreal lastDrawTime = 0; //< the time in [ms] the last render pass took
+    qreal lastPassTime = 0; //< the time in [ms] the last complete full detail pass took
+    bool previewEnabled = true;
+    quint32 contentVersion = 0; //< incremented by invalidate()
+
+    /**
+       @brief Copy the part of the last buffer still visible and draw the uncovered strips
+
+       @param buf   the buffer to draw
+       @param last  the last complete buffer with the same projection and scale
+
+       @return Return false if the buffers do not overlap and nothing has been drawn.
+     */
+    bool drawReused(buffer_t& buf, const buffer_t& last);
 };
 
 extern QPointF operator*(const QPointF& p1, const QPointF& p2);
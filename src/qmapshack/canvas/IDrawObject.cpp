@@ -18,12 +18,14 @@
 
 #include "canvas/IDrawContext.h"
 #include "canvas/IDrawObject.h"
+#include "CMainWindow.h"
 #include "units/IUnit.h"
 
 #include <QtWidgets>
 
 IDrawObject::IDrawObject(QObject *parent)
-    : QObject(parent)
+    // objects created by a worker thread can't have a parent of the GUI thread
+    : QObject((parent && parent->thread() == QThread::currentThread()) ? parent : nullptr)
 {
 }
 
@@ -62,6 +64,28 @@ bool IDrawObject::isOutOfScale(const QPointF& scale) const
     return false;
 }
 
+void IDrawObject::reportLoadError(const QString& title, const QString& msg)
+{
+    if(QThread::currentThread() == qApp->thread())
+    {
+        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), title, msg, QMessageBox::Abort, QMessageBox::Abort);
+    }
+    else
+    {
+        qWarning() << title << msg;
+        loadErrors << load_error_t {title, msg};
+    }
+}
+
+void IDrawObject::showLoadErrors()
+{
+    for(const load_error_t& error : loadErrors)
+    {
+        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), error.title, error.msg, QMessageBox::Abort, QMessageBox::Abort);
+    }
+    loadErrors.clear();
+}
+
 void IDrawObject::getLayers(QListWidget& list)
 {
     list.clear();
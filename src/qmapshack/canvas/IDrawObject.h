@@ -21,6 +21,7 @@
 
 #include "units/IUnit.h"
 #include <proj_api.h>
+#include <QList>
 #include <QObject>
 
 class QSettings;
@@ -94,6 +95,13 @@ public:
      */
     virtual void getLayers(QListWidget& list);
 
+    /**
+       @brief Show all messages collected by reportLoadError() while the object was created by a worker thread
+
+       Must be called from the GUI thread.
+     */
+    void showLoadErrors();
+
 public slots:
     /**
        @brief Write opacity value
@@ -131,6 +139,17 @@ protected:
     }
 
 
+    /**
+       @brief Report an error while loading the object to the user
+
+       If called from the GUI thread a message box is shown right away. Else the
+       message is stored to be shown by showLoadErrors() later on.
+
+       @param title     the message box title
+       @param msg       the message
+     */
+    void reportLoadError(const QString& title, const QString& msg);
+
     // draw tiles with low quality re-projection but fast
     void drawTileLQ(const QImage& img, QPolygonF& l, QPainter& p, IDrawContext& context, projPJ pjsrc, projPJ pjtar);
     // draw tiles with high quality re-projection but slow
@@ -143,6 +162,14 @@ private:
     qreal minScale = NOFLOAT;
     /// the maximum scale a map is visible
     qreal maxScale = NOFLOAT;
+
+    struct load_error_t
+    {
+        QString title;
+        QString msg;
+    };
+    /// errors reported while loaded by a worker thread
+    QList<load_error_t> loadErrors;
 };
 
 #endif //IDRAWOBJECT_H
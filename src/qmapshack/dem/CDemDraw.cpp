@@ -17,6 +17,7 @@
 **********************************************************************************************/
 
 #include "canvas/CCanvas.h"
+#include "canvas/CRenderStats.h"
 #include "CMainWindow.h"
 #include "dem/CDemDraw.h"
 #include "dem/CDemItem.h"
@@ -178,6 +179,11 @@ void CDemDraw::buildMapList()
 }
 
 
+void CDemDraw::updateDemListHelpText()
+{
+    demList->updateHelpText();
+}
+
 void CDemDraw::saveActiveMapsList(QStringList& keys)
 {
     SETTINGS;
@@ -195,7 +201,8 @@ void CDemDraw::saveActiveMapsList(QStringList& keys, QSettings& cfg)
     for(int i = 0; i < demList->count(); i++)
     {
         CDemItem * item = demList->item(i);
-        if(item && !item->demfile.isNull())
+        // DEMs still loading in the background are active, too
+        if(item && (!item->demfile.isNull() || item->loading))
         {
             item->saveConfig(cfg);
             keys << item->key;
@@ -234,7 +241,7 @@ void CDemDraw::restoreActiveMapsList(const QStringList& keys)
                     @Note   the item will load it's configuration upon successful activation
                             by calling loadConfigForDemItem().
                  */
-                item->activate();
+                item->activateAsync();
                 break;
             }
         }
@@ -371,7 +378,17 @@ void CDemDraw::drawt(buffer_t& currentBuffer)
                 break;
             }
 
-            item->demfile->draw(currentBuffer);
+            if(CRenderStats::isEnabled())
+            {
+                QElapsedTimer t;
+                t.start();
+                item->demfile->draw(currentBuffer);
+                CRenderStats::addTiming(canvas->objectName() + "/dem/" + item->text(0), t.nsecsElapsed() / 1000000.0);
+            }
+            else
+            {
+                item->demfile->draw(currentBuffer);
+            }
         }
     }
     CDemItem::mutexActiveDems.unlock();
@@ -71,8 +71,15 @@ public:
         return supportedFormats;
     }
 
+    /// update the help text of the DEM list, e.g. when a DEM finished loading in the background
+    void updateDemListHelpText();
+
 protected:
     void drawt(buffer_t& currentBuffer) override;
+    bool canReuseBuffer() const override
+    {
+        return true;
+    }
 
 private:
     /**
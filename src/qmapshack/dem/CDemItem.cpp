@@ -16,6 +16,7 @@
 
 **********************************************************************************************/
 
+#include "canvas/CDrawObjectLoader.h"
 #include "dem/CDemDraw.h"
 #include "dem/CDemItem.h"
 #include "dem/CDemVRT.h"
@@ -25,6 +26,7 @@
 #include <QtWidgets>
 
 QMutex CDemItem::mutexActiveDems(QMutex::Recursive);
+quint32 CDemItem::activationCnt = 0;
 
 CDemItem::CDemItem(QTreeWidget * parent, CDemDraw *dem)
     : QTreeWidgetItem(parent)
@@ -35,6 +37,7 @@ CDemItem::CDemItem(QTreeWidget * parent, CDemDraw *dem)
 
 CDemItem::~CDemItem()
 {
+    QObject::disconnect(connLoader);
 }
 
 void CDemItem::saveConfig(QSettings& cfg)
@@ -110,9 +113,15 @@ bool CDemItem::isActivated()
 bool CDemItem::toggleActivate()
 {
     QMutexLocker lock(&mutexActiveDems);
-    if(demfile.isNull())
+    if(loading)
     {
-        return activate();
+        cancelLoading();
+        return false;
+    }
+    else if(demfile.isNull())
+    {
+        activateAsync();
+        return true;
     }
     else
     {
@@ -140,24 +149,102 @@ void CDemItem::deactivate()
 }
 
 
+IDem * CDemItem::createDem(const QString& filename, CDemDraw * dem)
+{
+    // load map by suffix
+    const QString& suffix = QFileInfo(filename).suffix().toLower();
+    if(suffix == "vrt")
+    {
+        return new CDemVRT(filename, dem);
+    }
+    else if(suffix == "wcs")
+    {
+        return new CDemWCS(filename, dem);
+    }
+
+    return nullptr;
+}
+
 bool CDemItem::activate()
 {
     QMutexLocker lock(&mutexActiveDems);
 
+    cancelLoading();
     // remove demfile object
     delete demfile;
 
-    // load map by suffix
-    QFileInfo fi(filename);
-    if(fi.suffix().toLower() == "vrt")
+    activationIdx = ++activationCnt;
+    demfile = createDem(filename, dem);
+
+    return setupActivated();
+}
+
+void CDemItem::activateAsync()
+{
+    // WCS needs a network access manager in the GUI thread
+    QMutexLocker lock(&mutexActiveDems);
+    if(loading || !demfile.isNull())
     {
-        demfile = new CDemVRT(filename, dem);
+        return;
     }
-    else if(fi.suffix().toLower() == "wcs")
+
+    if(QFileInfo(filename).suffix().toLower() != "vrt")
     {
-        demfile = new CDemWCS(filename, dem);
+        activate();
+        return;
+    }
+
+    activationIdx = ++activationCnt;
+
+    const QString fn = filename;
+    CDemDraw * d     = dem;
+    CDrawObjectLoader * loader = new CDrawObjectLoader([fn, d]{ return createDem(fn, d); });
+    connLoader = QObject::connect(loader, &CDrawObjectLoader::finished, dem, [this, loader]{ finishLoading(loader); });
+
+    loading = true;
+    setIcon(0, QIcon("://icons/32x32/Time.png"));
+    setToolTip(0, tr("Loading..."));
+
+    loader->load();
+}
+
+void CDemItem::cancelLoading()
+{
+    if(!loading)
+    {
+        return;
     }
 
+    QObject::disconnect(connLoader);
+    loading = false;
+
+    updateIcon();
+    setToolTip(0, "");
+}
+
+void CDemItem::finishLoading(CDrawObjectLoader * loader)
+{
+    QObject::disconnect(connLoader);
+
+    IDem * obj = dynamic_cast<IDem*>(loader->takeObject());
+
+    QMutexLocker lock(&mutexActiveDems);
+    loading = false;
+    setToolTip(0, "");
+
+    demfile = obj;
+    if(!demfile.isNull())
+    {
+        demfile->setParent(dem);
+        demfile->showLoadErrors();
+    }
+
+    setupActivated();
+    dem->updateDemListHelpText();
+}
+
+bool CDemItem::setupActivated()
+{
     updateIcon();
 
     // no mapfiles loaded? Bad.
@@ -174,7 +261,7 @@ bool CDemItem::activate()
         return false;
     }
 
-    moveToBottom();
+    moveToActivationPosition();
 
     setFlags(flags() | Qt::ItemIsDragEnabled);
     /*
@@ -222,3 +309,23 @@ void CDemItem::moveToBottom()
 
     dem->emitSigCanvasUpdate();
 }
+
+void CDemItem::moveToActivationPosition()
+{
+    int row;
+    QTreeWidget * w = treeWidget();
+    QMutexLocker lock(&mutexActiveDems);
+
+    w->takeTopLevelItem(w->indexOfTopLevelItem(this));
+    for(row = 0; row < w->topLevelItemCount(); row++)
+    {
+        CDemItem * item = dynamic_cast<CDemItem*>(w->topLevelItem(row));
+        if(item && (item->demfile.isNull() || item->activationIdx > activationIdx))
+        {
+            break;
+        }
+    }
+    w->insertTopLevelItem(row, this);
+
+    dem->emitSigCanvasUpdate();
+}
@@ -19,17 +19,20 @@
 #ifndef CDEMITEM_H
 #define CDEMITEM_H
 
+#include <QCoreApplication>
 #include <QMutex>
 #include <QPointer>
 #include <QString>
 #include <QTreeWidgetItem>
 
 class IDem;
+class CDrawObjectLoader;
 class CDemDraw;
 class QSettings;
 
 class CDemItem : public QTreeWidgetItem
 {
+    Q_DECLARE_TR_FUNCTIONS(CDemItem)
 public:
     CDemItem(QTreeWidget *parent, CDemDraw *dem);
     virtual ~CDemItem();
@@ -47,9 +50,19 @@ public:
        @return True if the internal list of dem objects is not empty.
      */
     bool isActivated();
+    /**
+       @brief Query if the DEM is loaded in the background right now
+     */
+    bool isLoading() const
+    {
+        return loading;
+    }
     /**
        @brief Either loads or destroys internal map objects
-       @return True if the internal list of maps is not empty after the operation.
+
+       If the DEM is still loading in the background the loading is canceled.
+
+       @return True if the internal list of maps is not empty or the DEM is loading after the operation.
      */
     bool toggleActivate();
     /**
@@ -57,6 +70,12 @@ public:
      * @return Return true on success.
      */
     bool activate();
+    /**
+       @brief Load the DEM object in a worker thread
+
+       See CMapItem::activateAsync()
+     */
+    void activateAsync();
     /**
        @brief Delete all internal map objects
      */
@@ -81,7 +100,16 @@ public:
         return text(0);
     }
 
+    static IDem * createDem(const QString& filename, CDemDraw * dem);
+
 private:
+    void finishLoading(CDrawObjectLoader * loader);
+    void cancelLoading();
+    bool setupActivated();
+    void moveToActivationPosition();
+
+    static quint32 activationCnt;
+
     friend class CDemDraw;
     CDemDraw * dem;
     /**
@@ -96,6 +124,13 @@ private:
        @brief List of loaded map objects when map is activated.
      */
     QPointer<IDem> demfile;
+
+    /// the position in the order of activation
+    quint32 activationIdx = 0;
+    /// true while the DEM is loaded by a worker thread
+    bool loading = false;
+    /// connection to the loader's finished() signal
+    QMetaObject::Connection connLoader;
 };
 
 #endif //CDEMITEM_H
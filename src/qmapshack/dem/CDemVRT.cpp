@@ -17,6 +17,7 @@
 
 **********************************************************************************************/
 
+#include "canvas/CRenderStats.h"
 #include "CMainWindow.h"
 #include "dem/CDemDraw.h"
 #include "dem/CDemVRT.h"
@@ -42,7 +43,7 @@ CDemVRT::CDemVRT(const QString &filename, CDemDraw *parent)
     dataset = (GDALDataset*)GDALOpen(filename.toUtf8(), GA_ReadOnly);
     if(nullptr == dataset)
     {
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to load file: %1").arg(filename));
+        reportLoadError(tr("Error..."), tr("Failed to load file: %1").arg(filename));
         return;
     }
 
@@ -50,7 +51,7 @@ CDemVRT::CDemVRT(const QString &filename, CDemDraw *parent)
     {
         GDALClose(dataset);
         dataset = nullptr;
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("DEM must have one band with 16bit or 32bit data."));
+        reportLoadError(tr("Error..."), tr("DEM must have one band with 16bit or 32bit data."));
         return;
     }
 
@@ -59,7 +60,7 @@ CDemVRT::CDemVRT(const QString &filename, CDemDraw *parent)
     {
         GDALClose(dataset);
         dataset = nullptr;
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("DEM must have one band with 16bit or 32bit data."));
+        reportLoadError(tr("Error..."), tr("DEM must have one band with 16bit or 32bit data."));
         return;
     }
 
@@ -88,7 +89,7 @@ CDemVRT::CDemVRT(const QString &filename, CDemDraw *parent)
     {
         GDALClose(dataset);
         dataset = nullptr;
-        QMessageBox::warning(0, tr("Error..."), tr("No georeference information found."));
+        reportLoadError(tr("Error..."), tr("No georeference information found."));
         return;
     }
 
@@ -324,6 +325,13 @@ void CDemVRT::draw(IDrawContext::buffer_t& buf)
     qreal o2 = ((o1 + 0.4) >= 1.0) ? o1 : (o1 + 0.4);
     p.setOpacity(o1);
 
+    // the key stays empty if the statistics are off
+    QString keyStats;
+    if(CRenderStats::isEnabled())
+    {
+        keyStats = "dem/" + QFileInfo(filename).completeBaseName() + "/RasterIO";
+    }
+
     qreal nTiles = ((right - left) * (bottom - top) / (w * h));
     if(nTiles < TILELIMIT)
     {
@@ -372,6 +380,10 @@ void CDemVRT::draw(IDrawContext::buffer_t& buf)
                 mutex.lock();
                 err = dataset->RasterIO(GF_Read, x, y, wp2_used, hp2_used, data.data(), wp2_used, hp2_used, GDT_Int16, 1, 0, 0, 0, 0);
                 mutex.unlock();
+                if(!keyStats.isEmpty())
+                {
+                    CRenderStats::addCount(keyStats);
+                }
 
                 if(err)
                 {
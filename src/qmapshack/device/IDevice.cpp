@@ -347,7 +347,7 @@ bool IDevice::testForExternalProject(const QString& filename)
     return false;
 }
 
-void IDevice::drawItem(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, CGisDraw * gis)
+void IDevice::drawItem(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, CGisDraw * gis)
 {
     const int N = childCount();
     for(int n = 0; n < N; n++)
@@ -367,7 +367,7 @@ void IDevice::drawItem(QPainter& p, const QPolygonF &viewport, QList<QRectF>& bl
     }
 }
 
-void IDevice::drawLabel(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis)
+void IDevice::drawLabel(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis)
 {
     const int N = childCount();
     for(int n = 0; n < N; n++)
@@ -75,8 +75,8 @@ public:
     void getItemsByKeys(const QList<IGisItem::key_t>& keys, QList<IGisItem*>& items);
     void editItemByKey(const IGisItem::key_t& key);
 
-    void drawItem(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, CGisDraw * gis);
-    void drawLabel(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis);
+    void drawItem(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, CGisDraw * gis);
+    void drawLabel(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis);
     void drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis);
 
     void insertCopyOfProject(IGisProject * project, int& lastResult);
@@ -45,6 +45,7 @@
 #include "gis/ovl/CGisItemOvlArea.h"
 #include "gis/prj/IGisProject.h"
 #include "gis/qlb/CQlbProject.h"
+#include "gis/qms/CQmsCodec.h"
 #include "gis/qms/CQmsProject.h"
 #include "gis/rte/CGisItemRte.h"
 #include "gis/search/CGeoSearch.h"
@@ -69,7 +70,7 @@
 
 
 #undef  DB_VERSION
-#define DB_VERSION 4
+#define DB_VERSION 5
 
 class CGisListWksEditLock
 {
@@ -191,6 +192,9 @@ CGisListWks::CGisListWks(QWidget *parent)
     SETTINGS;
     saveOnExit  = cfg.value("Database/saveOnExit", saveOnExit).toBool();
     saveEvery   = cfg.value("Database/saveEvery",  saveEvery).toInt();
+    // the files loaded by --render and --bench are not part of the user's workspace
+    saveOnExit &= !qlOpts->isBatch();
+    CQmsCodec::setCodec(CQmsCodec::codec_e(cfg.value("Database/codec", CQmsCodec::getCodec()).toInt()));
 
     if(saveOnExit && (saveEvery > 0))
     {
@@ -280,7 +284,8 @@ void CGisListWks::initDB()
               "keyqms         TEXT NOT NULL,"
               "changed        BOOLEAN DEFAULT FALSE,"
               "visible        BOOLEAN DEFAULT TRUE,"
-              "data           BLOB NOT NULL"
+              "data           BLOB NOT NULL,"
+              "position       INTEGER DEFAULT 0"
               ")", NO_CMD)
 
     if(query.exec( "CREATE TABLE userfocus ( focus TEXT )"))
@@ -308,6 +313,10 @@ void CGisListWks::migrateDB(int version)
     {
         migrateDB3to4();
     }
+    if(version < 5)
+    {
+        migrateDB4to5();
+    }
 
     // save the new version to the database
     QSqlQuery query(db);
@@ -358,6 +367,17 @@ void CGisListWks::migrateDB3to4()
     }
 }
 
+void CGisListWks::migrateDB4to5()
+{
+    qDebug() << "migrating workspace.db from version 4 to version 5";
+    // add a new column `position` to the database
+    // projects are only written if they have changed. Their order in the
+    // workspace has to be stored explicitly as it can't be derived from the
+    // row id anymore. Old entries keep their order by the row id.
+    QSqlQuery query(db);
+    QUERY_RUN("ALTER TABLE workspace ADD COLUMN position INTEGER DEFAULT 0;", NO_CMD)
+}
+
 void CGisListWks::setExternalMenu(QMenu * project)
 {
     menuNone = project;
@@ -782,6 +802,35 @@ CDBProject * CGisListWks::getProjectById(quint64 id, const QString& db)
     return nullptr;
 }
 
+QByteArray CGisListWks::getWksFingerprint(IGisProject * project, bool visible)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream << qint32(project->getType()) << project->getGeneration();
+    stream << project->getKey() << project->getName() << project->getFilename();
+    stream << project->text(eColumnDecoration) << project->isChanged() << visible;
+
+    const int N = project->childCount();
+    for(int i = 0; i < N; i++)
+    {
+        IGisItem * item = dynamic_cast<IGisItem*>(project->child(i));
+        if(nullptr == item)
+        {
+            continue;
+        }
+
+        const IGisItem::history_t& history = item->getHistory();
+        stream << qint32(item->type()) << item->getKey().item << item->getHash();
+        stream << history.histIdxCurrent << qint32(history.events.size());
+        stream << item->isChanged() << item->getLastDatabaseHash();
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5);
+}
+
 void CGisListWks::slotSaveWorkspace()
 {
     CGisListWksEditLock lock(true, IGisItem::mutexItems);
@@ -791,47 +840,111 @@ void CGisListWks::slotSaveWorkspace()
         return;
     }
 
-    QSqlQuery query(db);
-    QUERY_RUN("DELETE FROM workspace", return )
-
     qDebug() << "slotSaveWorkspace()";
 
-    const int total = topLevelItemCount();
-    PROGRESS_SETUP(tr("Saving workspace. Please wait."), 0, total, this);
+    /*
+        Only projects that have changed since they have been written the last
+        time are serialized again. All others are either left as they are or
+        just get their new position. Everything is done in a single transaction
+        to keep the workspace consistent if QMapShack is terminated meanwhile.
+     */
+    QSqlQuery query(db);
+    QUERY_RUN("BEGIN TRANSACTION;", return )
+
+    QHash<IGisProject*, wks_project_t> projects;
+    quint32 cntWritten = 0;
 
-    for(int i = 0; i < total; i++)
-    {
-        PROGRESS(i, return );
+    {   // open context for progress dialog
+        const int total = topLevelItemCount();
+        PROGRESS_SETUP(tr("Saving workspace. Please wait."), 0, total, this);
 
-        IGisProject * project = dynamic_cast<IGisProject*>(topLevelItem(i));
-        if(nullptr == project)
+        for(int i = 0; i < total; i++)
         {
-            continue;
-        }
+            PROGRESS(i, query.exec("ROLLBACK;"); return );
+
+            IGisProject * project = dynamic_cast<IGisProject*>(topLevelItem(i));
+            if(nullptr == project)
+            {
+                continue;
+            }
 
-        QByteArray data;
-        QDataStream stream(&data, QIODevice::WriteOnly);
-        stream.setVersion(QDataStream::Qt_5_2);
-        stream.setByteOrder(QDataStream::LittleEndian);
+            bool visible            = (project->checkState(CGisListDB::eColumnCheckbox) == Qt::Checked);
+            wks_project_t entry     = wksProjects.value(project);
+            QByteArray fingerprint  = getWksFingerprint(project, visible);
 
-        project->IGisProject::operator>>(stream);
+            if(entry.id != 0 && entry.fingerprint == fingerprint)
+            {
+                if(entry.position != i)
+                {
+                    query.prepare("UPDATE workspace SET position=:position WHERE id=:id");
+                    query.bindValue(":position", i);
+                    query.bindValue(":id",       entry.id);
+                    QUERY_EXEC(query.exec("ROLLBACK;"); return );
+                    entry.position = i;
+                }
+                projects[project] = entry;
+                continue;
+            }
+
+            QByteArray data;
+            QDataStream stream(&data, QIODevice::WriteOnly);
+            stream.setVersion(QDataStream::Qt_5_2);
+            stream.setByteOrder(QDataStream::LittleEndian);
 
-        query.prepare("INSERT INTO workspace (type, keyqms, name, changed, visible, data) VALUES (:type, :keyqms, :name, :changed, :visible, :data)");
-        query.bindValue(":type",    project->getType());
-        query.bindValue(":keyqms",  project->getKey());
-        query.bindValue(":name",    project->getName());
-        query.bindValue(":changed", project->isChanged());
+            project->IGisProject::operator>>(stream);
 
-        bool visible = (project->checkState(CGisListDB::eColumnCheckbox) == Qt::Checked);
-        query.bindValue(":visible", visible);
-        query.bindValue(":data",    data);
-        QUERY_EXEC(continue);
+            if(entry.id != 0)
+            {
+                query.prepare("UPDATE workspace SET type=:type, keyqms=:keyqms, name=:name, changed=:changed, visible=:visible, data=:data, position=:position WHERE id=:id");
+                query.bindValue(":id",  entry.id);
+            }
+            else
+            {
+                query.prepare("INSERT INTO workspace (type, keyqms, name, changed, visible, data, position) VALUES (:type, :keyqms, :name, :changed, :visible, :data, :position)");
+            }
+            query.bindValue(":type",     project->getType());
+            query.bindValue(":keyqms",   project->getKey());
+            query.bindValue(":name",     project->getName());
+            query.bindValue(":changed",  project->isChanged());
+            query.bindValue(":visible",  visible);
+            query.bindValue(":data",     data);
+            query.bindValue(":position", i);
+            QUERY_EXEC(query.exec("ROLLBACK;"); return );
+
+            if(entry.id == 0)
+            {
+                entry.id = query.lastInsertId().toLongLong();
+            }
+            entry.position      = i;
+            entry.fingerprint   = fingerprint;
+            projects[project]   = entry;
+            cntWritten++;
+        }
+    } // close context for progress dialog
+
+    // remove the rows of all projects that have been closed meanwhile
+    // or that failed to load
+    QStringList ids;
+    for(const wks_project_t& entry : projects)
+    {
+        ids << QString::number(entry.id);
+    }
+    QString sql = "DELETE FROM workspace";
+    if(!ids.isEmpty())
+    {
+        sql += " WHERE id NOT IN (" + ids.join(",") + ")";
     }
+    QUERY_RUN(sql, query.exec("ROLLBACK;"); return )
 
     query.prepare( "UPDATE userfocus set focus=:focus");
     query.bindValue(":focus", IGisProject::getUserFocus());
     QUERY_EXEC();
 
+    QUERY_RUN("COMMIT;", query.exec("ROLLBACK;"); return )
+    wksProjects = projects;
+
+    qDebug() << "wrote" << cntWritten << "of" << projects.count() << "projects to workspace";
+
     if(saveEvery)
     {
         QTimer::singleShot(saveEvery * 60000, this, SLOT(slotSaveWorkspace()));
@@ -844,7 +957,9 @@ void CGisListWks::slotLoadWorkspace()
 
     QSqlQuery query(db);
 
-    QUERY_RUN("SELECT type, keyqms, name, changed, visible, data FROM workspace", return )
+    QUERY_RUN("SELECT id, type, keyqms, name, changed, visible, data, position FROM workspace ORDER BY position, id", return )
+
+    wksProjects.clear();
 
     { // open context for progress dialog
         const int total = query.size();
@@ -855,11 +970,13 @@ void CGisListWks::slotLoadWorkspace()
         {
             PROGRESS(progCnt++, return );
 
-            int type               = query.value(0).toInt();
-            QString name           = query.value(2).toString();
-            bool changed           = query.value(3).toBool();
-            Qt::CheckState visible = query.value(4).toBool() ? Qt::Checked : Qt::Unchecked;
-            QByteArray data        = query.value(5).toByteArray();
+            qint64 id              = query.value(0).toLongLong();
+            int type               = query.value(1).toInt();
+            QString name           = query.value(3).toString();
+            bool changed           = query.value(4).toBool();
+            Qt::CheckState visible = query.value(5).toBool() ? Qt::Checked : Qt::Unchecked;
+            QByteArray data        = query.value(6).toByteArray();
+            qint32 position        = query.value(7).toInt();
 
             QDataStream stream(&data, QIODevice::ReadOnly);
             stream.setVersion(QDataStream::Qt_5_2);
@@ -970,6 +1087,15 @@ void CGisListWks::slotLoadWorkspace()
                 {
                     project->setChanged();
                 }
+
+                // Remember the row the project has been restored from. Keep the
+                // stored position, even if it differs from the project's index
+                // (e.g. all rows have position 0 after migrateDB4to5()), to
+                // write the correct position with the next save.
+                wks_project_t& entry = wksProjects[project];
+                entry.id             = id;
+                entry.position       = position;
+                entry.fingerprint    = getWksFingerprint(project, visible == Qt::Checked);
             }
         }
     } // close context for progress dialog
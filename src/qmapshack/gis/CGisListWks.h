@@ -23,6 +23,7 @@
 #include "gis/prj/IGisProject.h"
 #include "gis/trk/CTrackData.h"
 
+#include <QHash>
 #include <QPointer>
 #include <QSqlDatabase>
 #include <QTreeWidget>
@@ -140,6 +141,7 @@ private:
     void migrateDB1to2();
     void migrateDB2to3();
     void migrateDB3to4();
+    void migrateDB4to5();
     void setVisibilityOnMap(bool visible);
     QAction * addSortAction(QObject *parent, QActionGroup *actionGroup, const QString& icon, const QString& text, IGisProject::sorting_folder_e mode);
     QAction * addAction(const QIcon& icon, const QString& name, QObject * parent, const char * slot);
@@ -171,8 +173,26 @@ private:
         return keys;
     }
 
+    /**
+       @brief Calculate a fingerprint of everything stored with the project in the workspace
+
+       The fingerprint covers the project's change generation, its decoration and the
+       current state of all items. It is much cheaper than serializing the project.
+     */
+    static QByteArray getWksFingerprint(IGisProject * project, bool visible);
+
     QSqlDatabase db;
 
+    /// the state of a project at the time it was last written to the workspace table
+    struct wks_project_t
+    {
+        qint64 id = 0;              //< row id in the workspace table
+        qint32 position = -1;       //< position in the list of projects
+        QByteArray fingerprint;     //< see getWksFingerprint()
+    };
+
+    QHash<IGisProject*, wks_project_t> wksProjects;
+
     QActionGroup * actionGroupSort;
     QAction * actionSave;
     QAction * actionSaveAs;
@@ -43,6 +43,7 @@
 #include "gis/trk/CGisItemTrk.h"
 #include "gis/wpt/CGisItemWpt.h"
 #include "gis/wpt/CProjWpt.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CInputDialog.h"
 #include "helpers/CProgressDialog.h"
 #include "helpers/CSelectCopyAction.h"
@@ -108,6 +109,12 @@ CGisWorkspace::~CGisWorkspace()
 
 void CGisWorkspace::slotLateInit()
 {
+    // --render and --bench load their files on their own
+    if(qlOpts->isBatch())
+    {
+        return;
+    }
+
     // [Issue #265] Delay the loading of the workspace to make sure the complete IUnit system
     //              is up and running.
     QTimer::singleShot(1000, treeWks, SLOT(slotLoadWorkspace()));
@@ -123,8 +130,9 @@ void CGisWorkspace::postEventForWks(QEvent * event)
     QCoreApplication::postEvent(treeWks, event);
 }
 
-void CGisWorkspace::loadGisProject(const QString& filename)
+IGisProject * CGisWorkspace::loadGisProject(const QString& filename)
 {
+    IGisProject * item = nullptr;
     // add project to workspace
     {
         CCanvasCursorLock cursorLock(Qt::WaitCursor, __func__);
@@ -132,7 +140,7 @@ void CGisWorkspace::loadGisProject(const QString& filename)
 
         QMutexLocker lock(&IGisItem::mutexItems);
 
-        IGisProject * item = IGisProject::create(filename, treeWks);
+        item = IGisProject::create(filename, treeWks);
         // skip if project is already loaded
         if(item && treeWks->hasProject(item))
         {
@@ -151,6 +159,7 @@ void CGisWorkspace::loadGisProject(const QString& filename)
     }
 
     emit sigChanged();
+    return item;
 }
 
 
@@ -1262,7 +1271,7 @@ void CGisWorkspace::editPrxWpt(const QList<IGisItem::key_t>& keys)
 void CGisWorkspace::draw(QPainter& p, const QPolygonF& viewport, CGisDraw * gis)
 {
     QFontMetricsF fm(CMainWindow::self().getMapFont());
-    QList<QRectF> blockedAreas;
+    CBlockedAreas blockedAreas;
 
     QMutexLocker lock(&IGisItem::mutexItems);
     // draw mandatory stuff first
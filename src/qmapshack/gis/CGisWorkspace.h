@@ -245,7 +245,13 @@ public:
     }
     virtual ~CGisWorkspace();
 
-    void loadGisProject(const QString& filename);
+    /**
+       @brief Load a project from file into the workspace
+
+       @param filename  the project's file
+       @return A temporary pointer to the loaded project. Null if the project has not been loaded.
+     */
+    IGisProject * loadGisProject(const QString& filename);
     /**
        @brief Draw all loaded data in the workspace that is visible
 
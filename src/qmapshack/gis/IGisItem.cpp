@@ -260,26 +260,30 @@ void IGisItem::loadFromDb(quint64 id, QSqlDatabase& db)
 
         if(key.item.isEmpty())
         {
-            QString keyFromDB = query.value(1).toString();
-            /*[Issue #72] Database/Workspace inconsistency in QMS 1.4.0
-
-               The root cause is a missing key in the serialized data. This is fixed by calling getKey() in setupHistory().
-
-               As the database has a valid key the complete history data has to be fixed with that key.
-             */
-            const int N = history.events.size();
-            for(int i = 0; i < N; i++)
-            {
-                loadHistory(i);
-                key.item = keyFromDB;
-                updateHistory();
-            }
+            restoreKeyFromDb(query.value(1).toString());
         }
 
         lastDatabaseHash = query.value(2).toString();
     }
 }
 
+void IGisItem::restoreKeyFromDb(const QString& keyFromDB)
+{
+    /*[Issue #72] Database/Workspace inconsistency in QMS 1.4.0
+
+       The root cause is a missing key in the serialized data. This is fixed by calling getKey() in setupHistory().
+
+       As the database has a valid key the complete history data has to be fixed with that key.
+     */
+    const int N = history.events.size();
+    for(int i = 0; i < N; i++)
+    {
+        loadHistory(i);
+        key.item = keyFromDB;
+        updateHistory();
+    }
+}
+
 void IGisItem::updateFromDB(quint64 id, QSqlDatabase& db)
 {
     QSqlQuery query(db);
@@ -414,6 +418,8 @@ void IGisItem::changed(const QString &what, const QString &icon)
         flags |= eFlagTainted;
     }
 
+    history.complete();
+
     // forget all history entries after the current entry
     for(int i = history.events.size() - 1; i > history.histIdxCurrent; i--)
     {
@@ -475,6 +481,9 @@ void IGisItem::setupHistory()
     // if history is empty setup an initial item
     if(history.events.isEmpty())
     {
+        // forget data left over from a history copied from another item
+        history.pendingData.clear();
+
         history.events << history_event_t();
         history_event_t& event = history.events.last();
         event.time      = QDateTime::currentDateTimeUtc();
@@ -521,6 +530,11 @@ void IGisItem::loadHistory(int idx)
         return;
     }
 
+    if(idx != history.histIdxCurrent)
+    {
+        history.complete();
+    }
+
     history_event_t& event = history.events[idx];
 
     // test for no data
@@ -540,6 +554,7 @@ void IGisItem::loadHistory(int idx)
 
 void IGisItem::cutHistoryAfter()
 {
+    history.complete();
     while(history.events.size() > (history.histIdxCurrent + 1))
     {
         history.events.pop_back();
@@ -548,6 +563,7 @@ void IGisItem::cutHistoryAfter()
 
 void IGisItem::cutHistoryBefore()
 {
+    history.complete();
     for (int i = 0; i < history.histIdxCurrent; i++)
     {
         history.events[i].data.clear();
@@ -561,6 +577,8 @@ void IGisItem::squashHistory()
         return;
     }
 
+    history.complete();
+
     history_event_t& first = history.events.first();
     history_event_t& last = history.events.last();
 
@@ -1059,6 +1077,40 @@ IGisItem * IGisItem::newGisItem(quint32 type, quint64 id, QSqlDatabase& db, IGis
     return item;
 }
 
+IGisItem * IGisItem::newGisItem(quint32 type, const history_t& history, const QString& keyFromDB, const QString& hash, IGisProject * project)
+{
+    IGisItem *item = nullptr;
+
+    switch(type)
+    {
+    case IGisItem::eTypeWpt:
+        item = new CGisItemWpt(history, hash, project);
+        break;
+
+    case IGisItem::eTypeTrk:
+        item = new CGisItemTrk(history, hash, project);
+        break;
+
+    case IGisItem::eTypeRte:
+        item = new CGisItemRte(history, hash, project);
+        break;
+
+    case IGisItem::eTypeOvl:
+        item = new CGisItemOvlArea(history, hash, project);
+        break;
+
+    default:
+        ;
+    }
+
+    if(item != nullptr && item->key.item.isEmpty())
+    {
+        item->restoreKeyFromDb(keyFromDB);
+    }
+
+    return item;
+}
+
 qreal IGisItem::getRating() const
 {
     return rating;
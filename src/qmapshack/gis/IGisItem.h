@@ -36,6 +36,7 @@
 
 #include "units/IUnit.h"
 
+class CBlockedAreas;
 class CGisDraw;
 class IScrOpt;
 class IMouse;
@@ -69,11 +70,39 @@ public:
             histIdxInitial = NOIDX;
             histIdxCurrent = NOIDX;
             events.clear();
+            pendingData.clear();
         }
 
+        /// true if the data of all events is available
+        bool isComplete() const
+        {
+            return pendingData.isEmpty();
+        }
+
+        /**
+           @brief Deserialize the data of all events but the current one
+
+           Only the current event is read with it's data when the history
+           is loaded. The data of all other events is kept serialized in
+           pendingData until it is needed by the history widget or undo/redo.
+         */
+        void complete();
+
+        /**
+           @brief Get the compressed item data of the current event
+
+           This is the data the item passes to CQmsCodec::uncompress() when it
+           is created from the history. It can be used to prefetch the result.
+
+           @return The compressed data or an empty array if there is no current event.
+         */
+        QByteArray getCurrentPayload() const;
+
         qint32 histIdxInitial;
         qint32 histIdxCurrent;
         QList<history_event_t> events;
+        /// serialized data of all events but the current one, not read yet
+        QByteArray pendingData;
     };
 
 
@@ -262,6 +291,12 @@ public:
      */
     void setLastDatabaseHash(quint64 id, QSqlDatabase& db);
 
+    /// set the hash of the database again, e.g. after the write of the item has been rolled back
+    void restoreLastDatabaseHash(const QString& hash)
+    {
+        lastDatabaseHash = hash;
+    }
+
     /**
        @brief Get the icon attached to object
        @return
@@ -421,11 +456,11 @@ public:
      */
     virtual bool setReadOnlyMode(bool readOnly);
 
-    virtual void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis) = 0;
+    virtual void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis) = 0;
     virtual void drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis)
     {
     }
-    virtual void drawLabel(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) = 0;
+    virtual void drawLabel(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) = 0;
     virtual void drawHighlight(QPainter& p) = 0;
 
     virtual void gainUserFocus(bool yes) = 0;
@@ -470,6 +505,17 @@ public:
         return history;
     }
 
+    /**
+       @brief Get read access to history of changes with the data of all events
+
+       @return A reference to the history structure.
+     */
+    const history_t& getCompleteHistory()
+    {
+        history.complete();
+        return history;
+    }
+
     /**
        @brief Load a given state of change from the history
        @param idx
@@ -571,6 +617,22 @@ public:
 
     static IGisItem * newGisItem(quint32 type, quint64 id, QSqlDatabase& db, IGisProject * project);
 
+    /**
+       @brief Create a new item from a history already read from the database
+
+       This is the counterpart of newGisItem() above for items fetched in bulk
+       by a background loader. The result is the same as if the item was loaded
+       by it's database ID.
+
+       @param type      the item type
+       @param history   the item's history as deserialized from the items.data column
+       @param keyFromDB the content of the items.keyqms column
+       @param hash      the content of the items.hash column
+       @param project   the project to add the item to
+       @return A pointer to the new item or nullptr for an unknown type.
+     */
+    static IGisItem * newGisItem(quint32 type, const history_t& history, const QString& keyFromDB, const QString& hash, IGisProject * project);
+
 
     /// a no key value that can be used to nullify references.
     const static QString noKey;
@@ -624,6 +686,8 @@ protected:
     virtual void changed(const QString& what, const QString& icon);
 
     void loadFromDb(quint64 id, QSqlDatabase& db);
+    /// fix a history without item key by the key stored in the database
+    void restoreKeyFromDb(const QString& keyFromDB);
     bool isVisible(const QRectF& rect, const QPolygonF& viewport, CGisDraw * gis);
     bool isVisible(const QPointF& point, const QPolygonF& viewport, CGisDraw * gis);
     bool isWithin(const QRectF& area, selflags_t flags, const QPolygonF& points);
@@ -19,6 +19,8 @@
 #include "gis/CGisListDB.h"
 #include "gis/db/CDBFolderGroup.h"
 
+#include <QtSql>
+
 CDBFolderGroup::CDBFolderGroup(QSqlDatabase& db, quint64 key, QTreeWidgetItem * parent)
     : IDBFolder(false, db, eTypeGroup, key, parent)
 {
@@ -26,6 +28,13 @@ CDBFolderGroup::CDBFolderGroup(QSqlDatabase& db, quint64 key, QTreeWidgetItem *
     setupFromDB();
 }
 
+CDBFolderGroup::CDBFolderGroup(QSqlDatabase& db, const QSqlQuery& query, QTreeWidgetItem * parent)
+    : IDBFolder(false, db, eTypeGroup, query.value(0).toULongLong(), parent)
+{
+    setIcon(CGisListDB::eColumnCheckbox, QIcon("://icons/32x32/PathBlue.png"));
+    setupFromQuery(query);
+}
+
 CDBFolderGroup::~CDBFolderGroup()
 {
 }
@@ -25,6 +25,7 @@ class CDBFolderGroup : public IDBFolder
 {
 public:
     CDBFolderGroup(QSqlDatabase &db, quint64 key, QTreeWidgetItem * parent);
+    CDBFolderGroup(QSqlDatabase &db, const QSqlQuery& query, QTreeWidgetItem * parent);
     virtual ~CDBFolderGroup();
 };
 
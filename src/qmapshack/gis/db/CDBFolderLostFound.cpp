@@ -46,11 +46,10 @@ void CDBFolderLostFound::setupFromDB()
 
     qDeleteAll(takeChildren());
 
-    QUERY_RUN("SELECT id FROM items AS t1 WHERE NOT EXISTS(SELECT * FROM folder2item WHERE child=t1.id) ORDER BY t1.type, t1.name", return );
+    QUERY_RUN("SELECT t1.id, t1.type, t1.keyqms, t1.icon, t1.name, t1.date, t1.trash FROM items AS t1 WHERE NOT EXISTS(SELECT * FROM folder2item WHERE child=t1.id) ORDER BY t1.type, t1.name", return );
     while(query.next())
     {
-        quint64 id = query.value(0).toULongLong();
-        new CDBItem(db, id, this);
+        new CDBItem(db, query, this);
         cnt++;
     }
 
@@ -20,6 +20,7 @@
 #include "gis/db/CDBFolderMysql.h"
 #include "gis/db/macros.h"
 
+#include <proj_api.h>
 #include <QtSql>
 
 CDBFolderMysql::CDBFolderMysql(const QString &server, const QString &port, const QString &user, const QString & passwd, bool noPasswd, const QString &name, QTreeWidget *parent)
@@ -91,6 +92,20 @@ bool CDBFolderMysql::search(const QString& str, QSqlQuery &query)
     return true;
 }
 
+bool CDBFolderMysql::searchArea(const QRectF& area, QSqlQuery& query)
+{
+    const QRectF& rect = area.normalized();
+
+    query.prepare("SELECT id FROM itemarea WHERE west <= :east AND east >= :west AND south <= :north AND north >= :south");
+    query.bindValue(":west",  rect.left()   * RAD_TO_DEG);
+    query.bindValue(":east",  rect.right()  * RAD_TO_DEG);
+    query.bindValue(":south", rect.top()    * RAD_TO_DEG);
+    query.bindValue(":north", rect.bottom() * RAD_TO_DEG);
+    QUERY_EXEC(return false);
+
+    return true;
+}
+
 void CDBFolderMysql::copyFolder(quint64 child, quint64 parent) //override;
 {
     QSqlQuery query(IDB::db);
@@ -19,6 +19,8 @@
 #include "gis/CGisListDB.h"
 #include "gis/db/CDBFolderOther.h"
 
+#include <QtSql>
+
 CDBFolderOther::CDBFolderOther(QSqlDatabase& db, quint64 key, QTreeWidgetItem * parent)
     : IDBFolder(true, db, eTypeOther, key, parent)
 {
@@ -26,6 +28,13 @@ CDBFolderOther::CDBFolderOther(QSqlDatabase& db, quint64 key, QTreeWidgetItem *
     setupFromDB();
 }
 
+CDBFolderOther::CDBFolderOther(QSqlDatabase& db, const QSqlQuery& query, QTreeWidgetItem * parent)
+    : IDBFolder(true, db, eTypeOther, query.value(0).toULongLong(), parent)
+{
+    setIcon(CGisListDB::eColumnCheckbox, QIcon("://icons/32x32/PathOrange.png"));
+    setupFromQuery(query);
+}
+
 CDBFolderOther::~CDBFolderOther()
 {
 }
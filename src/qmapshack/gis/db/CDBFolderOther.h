@@ -25,6 +25,7 @@ class CDBFolderOther : public IDBFolder
 {
 public:
     CDBFolderOther(QSqlDatabase &db, quint64 key, QTreeWidgetItem *parent);
+    CDBFolderOther(QSqlDatabase &db, const QSqlQuery& query, QTreeWidgetItem *parent);
     virtual ~CDBFolderOther();
 };
 
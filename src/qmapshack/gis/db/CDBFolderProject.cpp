@@ -19,6 +19,8 @@
 #include "gis/CGisListDB.h"
 #include "gis/db/CDBFolderProject.h"
 
+#include <QtSql>
+
 CDBFolderProject::CDBFolderProject(QSqlDatabase& db, quint64 key, QTreeWidgetItem * parent)
     : IDBFolder(true, db, eTypeProject, key, parent)
 {
@@ -26,6 +28,13 @@ CDBFolderProject::CDBFolderProject(QSqlDatabase& db, quint64 key, QTreeWidgetIte
     setupFromDB();
 }
 
+CDBFolderProject::CDBFolderProject(QSqlDatabase& db, const QSqlQuery& query, QTreeWidgetItem * parent)
+    : IDBFolder(true, db, eTypeProject, query.value(0).toULongLong(), parent)
+{
+    setIcon(CGisListDB::eColumnCheckbox, QIcon("://icons/32x32/PathGreen.png"));
+    setupFromQuery(query);
+}
+
 CDBFolderProject::~CDBFolderProject()
 {
 }
@@ -25,6 +25,7 @@ class CDBFolderProject : public IDBFolder
 {
 public:
     CDBFolderProject(QSqlDatabase &db, quint64 key, QTreeWidgetItem *parent);
+    CDBFolderProject(QSqlDatabase &db, const QSqlQuery& query, QTreeWidgetItem *parent);
     virtual ~CDBFolderProject();
 };
 
@@ -20,6 +20,7 @@
 #include "gis/db/CDBFolderSqlite.h"
 #include "gis/db/macros.h"
 
+#include <proj_api.h>
 #include <QtSql>
 #include <QtWidgets>
 
@@ -78,6 +79,20 @@ bool CDBFolderSqlite::search(const QString& str, QSqlQuery& query)
     return true;
 }
 
+bool CDBFolderSqlite::searchArea(const QRectF& area, QSqlQuery& query)
+{
+    const QRectF& rect = area.normalized();
+
+    query.prepare("SELECT id FROM itemarea WHERE west <= :east AND east >= :west AND south <= :north AND north >= :south");
+    query.bindValue(":west",  rect.left()   * RAD_TO_DEG);
+    query.bindValue(":east",  rect.right()  * RAD_TO_DEG);
+    query.bindValue(":south", rect.top()    * RAD_TO_DEG);
+    query.bindValue(":north", rect.bottom() * RAD_TO_DEG);
+    QUERY_EXEC(return false);
+
+    return true;
+}
+
 void CDBFolderSqlite::copyFolder(quint64 child, quint64 parent) //override;
 {
     QSqlQuery query(IDB::db);
@@ -24,36 +24,81 @@
 
 #include <QtSql>
 
+QHash<QByteArray, QIcon> CDBItem::icons;
+
 CDBItem::CDBItem(QSqlDatabase &db, quint64 id, IDBFolder *parent)
     : QTreeWidgetItem(parent)
     , db(db)
     , id(id)
 {
     QSqlQuery query(db);
-    query.prepare("SELECT type, keyqms, icon, name, date, comment FROM items WHERE id=:id");
+    query.prepare("SELECT id, type, keyqms, icon, name, date, trash FROM items WHERE id=:id");
     query.bindValue(":id", id);
     QUERY_EXEC(return );
     if(query.next())
+    {
+        setup(query);
+    }
+}
+
+CDBItem::CDBItem(QSqlDatabase &db, const QSqlQuery &query, IDBFolder *parent)
+    : QTreeWidgetItem(parent)
+    , db(db)
+{
+    setup(query);
+}
+
+void CDBItem::setup(const QSqlQuery& query)
+{
+    id   = query.value(0).toULongLong();
+    type = query.value(1).toInt();
+    key  = query.value(2).toString();
+    setIcon(CGisListDB::eColumnCheckbox, getIcon(query.value(3).toByteArray()));
+    setText(CGisListDB::eColumnName, query.value(4).toString());
+
+    date = query.value(5).toDateTime();
+
+    setAge(query.value(6).toString());
+}
+
+QIcon CDBItem::getIcon(const QByteArray& data)
+{
+    if(!icons.contains(data))
     {
         QPixmap pixmap;
-        type = query.value(0).toInt();
-        key  = query.value(1).toString();
-        pixmap.loadFromData(query.value(2).toByteArray(), "PNG");
-        setIcon(CGisListDB::eColumnCheckbox, pixmap);
-        setText(CGisListDB::eColumnName, query.value(3).toString());
+        pixmap.loadFromData(data, "PNG");
+        icons[data] = QIcon(pixmap);
+    }
+    return icons[data];
+}
+
+QVariant CDBItem::data(int column, int role) const
+{
+    if((column != CGisListDB::eColumnName) || (role != Qt::ToolTipRole))
+    {
+        return QTreeWidgetItem::data(column, role);
+    }
 
-        date = query.value(4).toDateTime();
+    if(!commentLoaded)
+    {
+        commentLoaded = true;
 
-        // limit comment to 300 characters
-        QString comment = query.value(5).toString();
-        if(comment.size() > 300)
+        QSqlQuery query(db);
+        query.prepare("SELECT comment FROM items WHERE id=:id");
+        query.bindValue(":id", id);
+        QUERY_EXEC(return QVariant());
+        if(query.next())
         {
-            comment = comment.left(297) + "...";
+            // limit comment to 300 characters
+            comment = query.value(0).toString();
+            if(comment.size() > 300)
+            {
+                comment = comment.left(297) + "...";
+            }
         }
-        setToolTip(CGisListDB::eColumnName, comment);
     }
 
-    updateAge();
+    return comment;
 }
 
 
@@ -73,9 +118,13 @@ void CDBItem::updateAge()
         return;
     }
 
+    setAge(query.value(0).toString());
+}
+
+void CDBItem::setAge(const QString& date)
+{
     if((parent() != nullptr) && (parent()->type() == IDBFolder::eTypeLostFound))
     {
-        QString date = query.value(0).toString();
         QDateTime timestamp;
 
         // The time format can differ by database type
@@ -20,18 +20,40 @@
 #define CDBITEM_H
 
 #include <QCoreApplication>
+#include <QHash>
+#include <QIcon>
 #include <QTreeWidgetItem>
 
 class IDBFolder;
 class QSqlDatabase;
+class QSqlQuery;
 
 class CDBItem : public QTreeWidgetItem
 {
     Q_DECLARE_TR_FUNCTIONS(CDBItem)
 public:
     CDBItem(QSqlDatabase& db, quint64 id, IDBFolder * parent);
+    /**
+       @brief Create the item from the current row of a query
+
+       This avoids a query per item if all items of a folder are read at once.
+       The query has to select the columns
+
+           id, type, keyqms, icon, name, date, trash
+
+       of the table `items` in exactly that order.
+     */
+    CDBItem(QSqlDatabase& db, const QSqlQuery& query, IDBFolder * parent);
     virtual ~CDBItem() = default;
 
+    /**
+       @brief Load the comment for the tooltip on demand
+
+       The comment is not needed until the user hovers over the item. Reading
+       it with the item would cost a lot for large folders.
+     */
+    QVariant data(int column, int role) const override;
+
     /**
        @brief Get the database id
        @return The ID value used by the database
@@ -53,6 +75,12 @@ public:
         return key;
     }
 
+    /// get the item type, one of IGisItem::type_e
+    int getType() const
+    {
+        return type;
+    }
+
 
     QString getName() const;
 
@@ -73,12 +101,22 @@ public:
 
 private:
     friend bool sortByTime(CDBItem * item1, CDBItem * item2);
+    void setup(const QSqlQuery& query);
+    void setAge(const QString& date);
+    static QIcon getIcon(const QByteArray& data);
+
     QSqlDatabase& db;
-    quint64 id;
+    quint64 id = 0;
 
     int type = 0;
     QString key;
     QDateTime date;
+
+    mutable bool commentLoaded = false;
+    mutable QString comment;
+
+    /// decoded item icons by PNG data. Most items share a few icons.
+    static QHash<QByteArray, QIcon> icons;
 };
 
 #endif //CDBITEM_H
@@ -0,0 +1,126 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "gis/db/CDBItemLoader.h"
+#include "gis/db/IDB.h"
+#include "gis/db/macros.h"
+#include "gis/qms/CQmsCodec.h"
+
+#include <QtSql>
+
+#define DB_LOADER_BATCH_SIZE 100
+
+CDBItemLoader::CDBItemLoader(const QList<quint64>& ids, QSqlDatabase &db, QObject *parent)
+    : QThread(parent)
+    , ids(ids)
+    , dbParent(db)
+{
+}
+
+CDBItemLoader::~CDBItemLoader()
+{
+    slotAbort();
+    wait();
+}
+
+QList<CDBItemLoader::item_t> CDBItemLoader::takeItems()
+{
+    QMutexLocker lock(&mutex);
+    QList<item_t> result;
+    result.swap(items);
+    return result;
+}
+
+void CDBItemLoader::slotAbort()
+{
+    QMutexLocker lock(&mutex);
+    keepGoing = false;
+}
+
+bool CDBItemLoader::getKeepGoing() const
+{
+    QMutexLocker lock(&mutex);
+    return keepGoing;
+}
+
+void CDBItemLoader::run()
+{
+    {
+        QMutexLocker lock(&mutex);
+        keepGoing = true;
+    }
+
+    const QString connectionName = QString("tmp_loader_%1").arg(quintptr(this), 0, 16);
+    {
+        QSqlDatabase db = QSqlDatabase::cloneDatabase(dbParent, connectionName);
+        if(!db.open())
+        {
+            qWarning() << "Failed to open database for loading items:" << db.lastError().text();
+        }
+        else
+        {
+            QSqlQuery query(db);
+            for(int i = 0; i < ids.size() && getKeepGoing(); i += DB_LOADER_BATCH_SIZE)
+            {
+                // the IDs are plain integers from the database. It's safe to
+                // put them directly into the statement.
+                QStringList batch;
+                for(quint64 id : ids.mid(i, DB_LOADER_BATCH_SIZE))
+                {
+                    batch << QString::number(id);
+                }
+
+                QUERY_RUN("SELECT id, type, data, keyqms, hash FROM items WHERE id IN (" + batch.join(",") + ")", break);
+
+                QList<item_t> loaded;
+                while(query.next())
+                {
+                    item_t item;
+                    item.id     = query.value(0).toULongLong();
+                    item.type   = query.value(1).toUInt();
+                    item.keyqms = query.value(3).toString();
+                    item.hash   = query.value(4).toString();
+
+                    QByteArray data(query.value(2).toByteArray());
+                    QDataStream in(&data, QIODevice::ReadOnly);
+                    in.setByteOrder(QDataStream::LittleEndian);
+                    in.setVersion(QDataStream::Qt_5_2);
+                    in >> item.history;
+
+                    // uncompressing is the expensive part of creating the item later on
+                    const QByteArray payload = item.history.getCurrentPayload();
+                    if(!payload.isEmpty())
+                    {
+                        CQmsCodec::prefetch(payload);
+                    }
+
+                    loaded << item;
+                }
+
+                {
+                    QMutexLocker lock(&mutex);
+                    items += loaded;
+                }
+                emit sigItemsLoaded();
+            }
+            IDB::clearCached(connectionName);
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
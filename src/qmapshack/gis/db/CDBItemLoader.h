@@ -0,0 +1,85 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CDBITEMLOADER_H
+#define CDBITEMLOADER_H
+
+#include "gis/IGisItem.h"
+
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QThread>
+
+/**
+   @brief Fetch items from the database in a worker thread
+
+   Instead of one query per item the items are read in batches of
+   DB_LOADER_BATCH_SIZE items per query. The history blobs are deserialized
+   and the item data of the current event is uncompressed (see
+   CQmsCodec::prefetch()) in the worker thread, too. The GUI thread collects
+   the loaded items with takeItems() and creates the actual IGisItem objects
+   from the history. This can't be done by the worker, as items are tree
+   widget items with pixmaps.
+
+   As database connections can't be shared between threads the connection
+   of the parent is cloned.
+ */
+class CDBItemLoader : public QThread
+{
+    Q_OBJECT
+public:
+    struct item_t
+    {
+        quint64 id = 0;
+        quint32 type = 0;
+        IGisItem::history_t history;
+        QString keyqms;
+        QString hash;
+    };
+
+    CDBItemLoader(const QList<quint64>& ids, QSqlDatabase& db, QObject * parent);
+    virtual ~CDBItemLoader();
+
+    /// take all items loaded since the last call
+    QList<item_t> takeItems();
+
+signals:
+    /// emitted each time a batch of items is ready to be taken
+    void sigItemsLoaded();
+
+public slots:
+    void slotAbort();
+
+protected:
+    void run() override;
+    bool getKeepGoing() const;
+
+private:
+    mutable QMutex mutex;
+    bool keepGoing = false;
+
+    /// the item IDs to load
+    QList<quint64> ids;
+    /// database connection from the main thread
+    QSqlDatabase& dbParent;
+    /// items loaded but not taken yet
+    QList<item_t> items;
+};
+
+#endif //CDBITEMLOADER_H
+
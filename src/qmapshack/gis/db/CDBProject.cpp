@@ -19,6 +19,7 @@
 #include "CMainWindow.h"
 #include "gis/CGisDatabase.h"
 #include "gis/CGisWorkspace.h"
+#include "gis/db/CDBItemLoader.h"
 #include "gis/db/CDBProject.h"
 #include "gis/db/CResolveDatabaseConflict.h"
 #include "gis/db/CSelectSaveAction.h"
@@ -27,6 +28,7 @@
 #include "gis/gpx/CGpxProject.h"
 #include "gis/ovl/CGisItemOvlArea.h"
 #include "gis/prj/CDetailsPrj.h"
+#include "gis/qms/CQmsCodec.h"
 #include "gis/qms/CQmsProject.h"
 #include "gis/rte/CGisItemRte.h"
 #include "gis/trk/CGisItemTrk.h"
@@ -38,6 +40,13 @@
 
 #include <QtSql>
 #include <QtWidgets>
+
+/// below this number of items they are loaded one by one in the GUI thread
+#define DB_LOADER_THRESHOLD 50
+#define DB_LOADER_MAX_THREADS 4
+/// the number of items written to the database in one transaction
+#define DB_SAVE_BATCH_SIZE 50
+
 CDBProject::CDBProject(CGisListWks * parent)
     : IGisProject(eTypeDb, "", parent)
     , id(0)
@@ -274,9 +283,9 @@ CDBProject::action_e CDBProject::checkForAction2(IGisItem * item, quint64 &itemI
 {
     action_e action = eActionNone;
 
-    query.prepare("SELECT hash, last_user, last_change FROM items WHERE id=:id");
+    IDB::prepareCached(db, query, "SELECT hash, last_user, last_change FROM items WHERE id=:id");
     query.bindValue(":id", itemId);
-    QUERY_EXEC(throw eReasonQueryFail);
+    QUERY_EXEC_CACHED(throw eReasonQueryFail);
 
     if(query.next())
     {
@@ -298,6 +307,11 @@ CDBProject::action_e CDBProject::checkForAction2(IGisItem * item, quint64 &itemI
             "your version and take the one from the database"
             ).arg(item->getNameEx()).arg(user).arg(date);
 
+        // don't keep anything locked while waiting for the user
+        if(!commitBatch())
+        {
+            throw eReasonCommitFail;
+        }
         CResolveDatabaseConflict dialog (msg, item, action2ForAll, CMainWindow::self().getBestWidgetForParent());
         action = dialog.getAction();
     }
@@ -331,7 +345,7 @@ void CDBProject::updateItem(IGisItem *&item, quint64 idItem, action_e& action2Fo
 
     QString hashInDb = item->getLastDatabaseHash();
 
-    query.prepare("UPDATE items SET type=:type, keyqms=:keyqms, icon=:icon, name=:name, date=:date, comment=:comment, data=:data, hash=:hash WHERE id=:id AND hash=:oldhash");
+    IDB::prepareCached(db, query, "UPDATE items SET type=:type, keyqms=:keyqms, icon=:icon, name=:name, date=:date, comment=:comment, data=:data, hash=:hash WHERE id=:id AND hash=:oldhash");
     query.bindValue(":type",    item->type());
     query.bindValue(":keyqms",  item->getKey().item);
     query.bindValue(":icon",    buffer.data());
@@ -342,13 +356,15 @@ void CDBProject::updateItem(IGisItem *&item, quint64 idItem, action_e& action2Fo
     query.bindValue(":hash",    item->getHash());
     query.bindValue(":id",      idItem);
     query.bindValue(":oldhash", hashInDb);
-    QUERY_EXEC(throw eReasonQueryFail);
+    QUERY_EXEC_CACHED(throw eReasonQueryFail);
 
     if(query.numRowsAffected())
     {
         // the update has been successful.
         // set current hash as database hash.
+        addToBatch(item, hashInDb);
         item->setLastDatabaseHash(idItem, db);
+        IDB::updateItemArea(db, idItem, item->getBoundingRect());
     }
     else
     {
@@ -368,10 +384,10 @@ void CDBProject::updateItem(IGisItem *&item, quint64 idItem, action_e& action2Fo
             delete item;
             item = item2;
 
-            query.prepare("INSERT INTO folder2item (parent, child) VALUES (:parent, :child)");
+            IDB::prepareCached(db, query, "INSERT INTO folder2item (parent, child) VALUES (:parent, :child)");
             query.bindValue(":parent", id);
             query.bindValue(":child", idItem);
-            QUERY_EXEC(throw eReasonQueryFail);
+            QUERY_EXEC_CACHED(throw eReasonQueryFail);
             break;
         }
 
@@ -379,7 +395,7 @@ void CDBProject::updateItem(IGisItem *&item, quint64 idItem, action_e& action2Fo
         {
             // hashInDb has been updated by checkForAction2() by the one stored in the database
             // therefore the update should succeed now.
-            query.prepare("UPDATE items SET type=:type, keyqms=:keyqms, icon=:icon, name=:name, date=:date, comment=:comment, data=:data, hash=:hash WHERE id=:id AND hash=:oldhash");
+            IDB::prepareCached(db, query, "UPDATE items SET type=:type, keyqms=:keyqms, icon=:icon, name=:name, date=:date, comment=:comment, data=:data, hash=:hash WHERE id=:id AND hash=:oldhash");
             query.bindValue(":type",    item->type());
             query.bindValue(":keyqms",  item->getKey().item);
             query.bindValue(":icon",    buffer.data());
@@ -390,11 +406,13 @@ void CDBProject::updateItem(IGisItem *&item, quint64 idItem, action_e& action2Fo
             query.bindValue(":hash",    item->getHash());
             query.bindValue(":id",      idItem);
             query.bindValue(":oldhash", hashInDb);
-            QUERY_EXEC(throw eReasonQueryFail);
+            QUERY_EXEC_CACHED(throw eReasonQueryFail);
 
             if(query.numRowsAffected())
             {
+                addToBatch(item, hashInDb);
                 item->setLastDatabaseHash(idItem, db);
+                IDB::updateItemArea(db, idItem, item->getBoundingRect());
             }
             else
             {
@@ -432,7 +450,7 @@ quint64 CDBProject::insertItem(IGisItem * item, QSqlQuery &query)
     pixmap.save(&buffer, "PNG");
     buffer.seek(0);
 
-    query.prepare("INSERT INTO items (type, keyqms, icon, name, date, comment, data, hash) VALUES (:type, :keyqms, :icon, :name, :date, :comment, :data, :hash)");
+    IDB::prepareCached(db, query, "INSERT INTO items (type, keyqms, icon, name, date, comment, data, hash) VALUES (:type, :keyqms, :icon, :name, :date, :comment, :data, :hash)");
     query.bindValue(":type",    item->type());
     query.bindValue(":keyqms",  item->getKey().item);
     query.bindValue(":icon",    buffer.data());
@@ -441,17 +459,24 @@ quint64 CDBProject::insertItem(IGisItem * item, QSqlQuery &query)
     query.bindValue(":comment", item->getInfo(IGisItem::eFeatureShowName | IGisItem::eFeatureShowFullText));
     query.bindValue(":data",    data);
     query.bindValue(":hash",    item->getHash());
-    QUERY_EXEC(throw eReasonQueryFail);
+    QUERY_EXEC_CACHED(throw eReasonQueryFail);
 
     if(query.numRowsAffected())
     {
-        idItem = IDB::getLastInsertID(db, "items");
+        // the driver knows the ID without asking the server again
+        idItem = query.lastInsertId().toULongLong();
+        if(idItem == 0)
+        {
+            idItem = IDB::getLastInsertID(db);
+        }
         if(idItem == 0)
         {
             qDebug() << "childId equals 0. bad.";
             throw eReasonUnexpected;
         }
+        addToBatch(item, QString());
         item->setLastDatabaseHash(idItem, db);
+        IDB::updateItemArea(db, idItem, item->getBoundingRect());
     }
     else
     {
@@ -467,9 +492,9 @@ CDBProject::action_e CDBProject::checkForAction1(IGisItem * item, quint64& itemI
 
     // test if item exists in database
     quint32 itemType = 0;
-    query.prepare("SELECT id, type FROM items WHERE keyqms=:keyqms");
+    IDB::prepareCached(db, query, "SELECT id, type FROM items WHERE keyqms=:keyqms");
     query.bindValue(":keyqms", item->getKey().item);
-    QUERY_EXEC(throw eReasonQueryFail);
+    QUERY_EXEC_CACHED(throw eReasonQueryFail);
 
 
     if(query.next())
@@ -478,10 +503,10 @@ CDBProject::action_e CDBProject::checkForAction1(IGisItem * item, quint64& itemI
         itemType    = query.value(1).toUInt();
 
         // check if relation already exists.
-        query.prepare("SELECT id FROM folder2item WHERE parent=:parent AND child=:child");
+        IDB::prepareCached(db, query, "SELECT id FROM folder2item WHERE parent=:parent AND child=:child");
         query.bindValue(":parent", id);
         query.bindValue(":child", itemId);
-        QUERY_EXEC(throw eReasonQueryFail);
+        QUERY_EXEC_CACHED(throw eReasonQueryFail);
 
         if(!query.next())
         {
@@ -490,6 +515,12 @@ CDBProject::action_e CDBProject::checkForAction1(IGisItem * item, quint64& itemI
 
             if(action1ForAll == CSelectSaveAction::eResultNone)
             {
+                // don't keep anything locked while waiting for the user
+                if(!commitBatch())
+                {
+                    throw eReasonCommitFail;
+                }
+
                 // Build the dialog to ask for user action
                 IGisItem * item1 = IGisItem::newGisItem(itemType, itemId, db, nullptr);
 
@@ -550,6 +581,58 @@ CDBProject::action_e CDBProject::checkForAction1(IGisItem * item, quint64& itemI
     return (action_e)action;
 }
 
+bool CDBProject::commitBatch(bool restart)
+{
+    if(!inTransaction)
+    {
+        return true;
+    }
+
+    bool success = IDB::commit(db);
+    if(success)
+    {
+        batch.clear();
+    }
+    else
+    {
+        qWarning() << "Commit failed:" << db.lastError();
+        errorCommit = db.lastError().text();
+        rollbackBatch();
+    }
+
+    inTransaction = restart && IDB::transaction(db);
+    return success;
+}
+
+void CDBProject::rollbackBatch()
+{
+    if(inTransaction)
+    {
+        IDB::rollback(db);
+        inTransaction = false;
+    }
+
+    // None of the items is in the database as written. Restore the hash
+    // and the marks in reverse order, as an item written twice has to
+    // end up with the state before its first write.
+    for(int i = batch.size() - 1; i >= 0; i--)
+    {
+        const batch_item_t& entry = batch[i];
+        entry.item->restoreLastDatabaseHash(entry.hash);
+        entry.item->updateDecoration(entry.marks, IGisItem::eMarkNone);
+    }
+    batch.clear();
+}
+
+void CDBProject::addToBatch(IGisItem * item, const QString& hashInDb)
+{
+    if(inTransaction)
+    {
+        const quint32 marks = item->data(1, Qt::UserRole).toUInt() & (IGisItem::eMarkChanged | IGisItem::eMarkNotPart | IGisItem::eMarkNotInDB);
+        batch << batch_item_t {item, hashInDb, marks};
+    }
+}
+
 bool CDBProject::save()
 {
     return save(CSelectSaveAction::eResultNone, eActionNone);
@@ -578,6 +661,11 @@ bool CDBProject::save(CSelectSaveAction::result_e action1ForAll, action_e action
     int N = childCount();
     PROGRESS_SETUP(tr("Save ..."), 0, N, CMainWindow::getBestWidgetForParent());
 
+    // Write the items in batches. Each commit is a round trip to a MySQL
+    // server and a sync to disk for SQLite.
+    inTransaction   = IDB::transaction(db);
+    int cntBatch    = 0;
+
     for(int i = 0; (i < N) && !stop; i++)
     {
         try
@@ -627,18 +715,46 @@ bool CDBProject::save(CSelectSaveAction::result_e action1ForAll, action_e action
 
             if((action & eActionLink) && (idItem != 0))
             {
-                query.prepare("INSERT INTO folder2item (parent, child) VALUES (:parent, :child)");
+                addToBatch(item, item->getLastDatabaseHash());
+                IDB::prepareCached(db, query, "INSERT INTO folder2item (parent, child) VALUES (:parent, :child)");
                 query.bindValue(":parent", id);
                 query.bindValue(":child", idItem);
-                QUERY_EXEC(throw eReasonQueryFail);
+                QUERY_EXEC_CACHED(throw eReasonQueryFail);
             }
             item->updateDecoration(IGisItem::eMarkNone, IGisItem::eMarkChanged | IGisItem::eMarkNotPart | IGisItem::eMarkNotInDB);
+
+            if(++cntBatch == DB_SAVE_BATCH_SIZE)
+            {
+                if(!commitBatch())
+                {
+                    throw eReasonCommitFail;
+                }
+                cntBatch = 0;
+            }
         }
         catch(reasons_e reason)
         {
+            if(reason == eReasonQueryFail)
+            {
+                // the connection might be gone with the transaction, drop the batch
+                rollbackBatch();
+            }
+            else if((reason != eReasonCommitFail) && !commitBatch())
+            {
+                // keep what has been written so far, as it was done without batches
+                reason = eReasonCommitFail;
+            }
+            cntBatch = 0;
+
             CProgressDialog::setAllVisible(false);
             switch(reason)
             {
+            case eReasonCommitFail:
+                QMessageBox::critical(&progress, tr("Error"), tr("Failed to commit the items to the database. The items of the last batch are not saved:\n\n%1").arg(errorCommit), QMessageBox::Abort);
+                stop    = true;
+                success = false;
+                break;
+
             case eReasonQueryFail:
                 QMessageBox::critical(&progress, tr("Error"), tr("There was an unexpected database error:\n\n%1").arg(query.lastError().text()), QMessageBox::Abort);
 
@@ -657,6 +773,14 @@ bool CDBProject::save(CSelectSaveAction::result_e action1ForAll, action_e action
         }
     }
 
+    if(!commitBatch(false))
+    {
+        CProgressDialog::setAllVisible(false);
+        QMessageBox::critical(&progress, tr("Error"), tr("Failed to commit the items to the database. The items of the last batch are not saved:\n\n%1").arg(errorCommit), QMessageBox::Abort);
+        CProgressDialog::setAllVisible(true);
+        success = false;
+    }
+
     // serialize metadata of project
     QByteArray data;
     QDataStream in(&data, QIODevice::WriteOnly);
@@ -691,44 +815,149 @@ void CDBProject::showItems(CEvtD2WShowItems * evt, action_e action2ForAll)
         qDeleteAll(takeChildren());
     }
 
-    for(const evt_item_t &item : evt->items)
+    // The background loader reports progress by a dialog. Therefore it can
+    // be used by the GUI thread only. Other threads, like the database
+    // export, load the items on their own.
+    if((evt->items.size() < DB_LOADER_THRESHOLD) || (QThread::currentThread() != qApp->thread()))
     {
-        IGisItem * gisItem = IGisItem::newGisItem(item.type, item.id, db, this);
+        for(const evt_item_t &item : evt->items)
+        {
+            IGisItem * gisItem = IGisItem::newGisItem(item.type, item.id, db, this);
+            fixLoadedItem(gisItem, item.id, action2ForAll);
+        }
+    }
+    else
+    {
+        loadItemsInBackground(evt->items, action2ForAll);
+    }
 
-        /* [Issue #72] Database/Workspace inconsistency in QMS 1.4.0
+    sortItems();
+    postStatus(false);
+    setToolTip(CGisListWks::eColumnName, getInfo());
 
-           When an item with no key is loaded it is "healed". The healing
-           will mark it as changed. To avoid this save all items that are
-           marked as changed right after loading from the database.
+    if(restoreDlgDetails)
+    {
+        edit();
+    }
+}
 
-         */
-        if(gisItem && gisItem->isChanged())
+void CDBProject::loadItemsInBackground(const QList<evt_item_t>& items, action_e& action2ForAll)
+{
+    // the progress dialog needs the GUI thread, see showItems()
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    const int N = items.size();
+    const int nThreads = qBound(1, QThread::idealThreadCount(), DB_LOADER_MAX_THREADS);
+    const int nPerThread = (N + nThreads - 1) / nThreads;
+
+    PROGRESS_SETUP(tr("Loading items from database..."), 0, N, CMainWindow::self().getBestWidgetForParent());
+
+    // Wait for the loaders by an event loop. It's stopped by each batch
+    // of items, a finished loader or the progress dialog's cancel button.
+    // As these signals might be processed by the progress dialog, too,
+    // they are counted to not wait for something that happened already.
+    QEventLoop loop;
+    int cntSignals = 0;
+    auto wakeUp = [&loop, &cntSignals]
+    {
+        cntSignals++;
+        loop.quit();
+    };
+    QObject::connect(&progress, &CProgressDialog::rejected, &loop, wakeUp);
+
+    QList<CDBItemLoader*> loaders;
+    for(int i = 0; i < N; i += nPerThread)
+    {
+        QList<quint64> ids;
+        for(const evt_item_t &item : items.mid(i, nPerThread))
         {
-            bool success = true;
-            try
+            ids << item.id;
+        }
+
+        CDBItemLoader * loader = new CDBItemLoader(ids, db, nullptr);
+        QObject::connect(loader, &CDBItemLoader::sigItemsLoaded, &loop, wakeUp);
+        QObject::connect(loader, &CDBItemLoader::finished, &loop, wakeUp);
+        loader->start();
+        loaders << loader;
+    }
+
+    QHash<quint64, CDBItemLoader::item_t> loaded;
+    int next = 0;
+    while(next < N)
+    {
+        cntSignals = 0;
+
+        // test for finished loaders first. Items taken afterwards are complete.
+        bool allFinished = true;
+        for(CDBItemLoader * loader : loaders)
+        {
+            allFinished = loader->isFinished() && allFinished;
+            for(const CDBItemLoader::item_t &item : loader->takeItems())
             {
-                QSqlQuery query(db);
-                updateItem(gisItem, item.id, action2ForAll, query);
+                loaded[item.id] = item;
             }
-            catch(int)
+        }
+
+        // add items in their original order as far as they are available
+        const int nLast = next;
+        while(next < N)
+        {
+            const evt_item_t &evtItem = items[next];
+            if(loaded.contains(evtItem.id))
             {
-                success = false;
+                const CDBItemLoader::item_t &item = loaded[evtItem.id];
+                IGisItem * gisItem = IGisItem::newGisItem(item.type, item.history, item.keyqms, item.hash, this);
+                fixLoadedItem(gisItem, item.id, action2ForAll);
+                loaded.remove(evtItem.id);
             }
-
-            if(success)
+            else if(!allFinished)
             {
-                gisItem->updateDecoration(IGisItem::eMarkNone, IGisItem::eMarkChanged);
+                break;
             }
+            // items not found at all are skipped like newGisItem() would do
+
+            next++;
+        }
+
+        PROGRESS(next, break);
+
+        if(next == nLast && !allFinished && cntSignals == 0)
+        {
+            loop.exec();
         }
     }
 
-    sortItems();
-    postStatus(false);
-    setToolTip(CGisListWks::eColumnName, getInfo());
+    qDeleteAll(loaders);
+    // drop the data prefetched for items not created because of a cancel
+    CQmsCodec::clearPrefetched();
+}
 
-    if(restoreDlgDetails)
+void CDBProject::fixLoadedItem(IGisItem * gisItem, quint64 idItem, action_e& action2ForAll)
+{
+    /* [Issue #72] Database/Workspace inconsistency in QMS 1.4.0
+
+       When an item with no key is loaded it is "healed". The healing
+       will mark it as changed. To avoid this save all items that are
+       marked as changed right after loading from the database.
+
+     */
+    if(gisItem && gisItem->isChanged())
     {
-        edit();
+        bool success = true;
+        try
+        {
+            QSqlQuery query(db);
+            updateItem(gisItem, idItem, action2ForAll, query);
+        }
+        catch(int)
+        {
+            success = false;
+        }
+
+        if(success)
+        {
+            gisItem->updateDecoration(IGisItem::eMarkNone, IGisItem::eMarkChanged);
+        }
     }
 }
 
@@ -23,6 +23,7 @@
 #include "gis/prj/IGisProject.h"
 #include <QSqlDatabase>
 class CEvtD2WShowItems;
+struct evt_item_t;
 class CEvtD2WHideItems;
 class CQlgtFolder;
 class IDBFolder;
@@ -147,8 +148,55 @@ protected:
      */
     quint64 insertItem(IGisItem * item, QSqlQuery& query);
 
+    /**
+       @brief Load a large number of items by background loaders
+
+       The items are fetched in batches and deserialized by several
+       CDBItemLoader threads. The GUI stays responsive and shows the progress
+       while the items are added to the project in their original order.
+
+       @note Has to be called by the GUI thread.
+
+       @param items             the list of items to load
+       @param action2ForAll     the save action used for items fixed while loading
+     */
+    void loadItemsInBackground(const QList<evt_item_t>& items, action_e& action2ForAll);
+
+    /// save items "healed" while loading right away to the database
+    void fixLoadedItem(IGisItem * gisItem, quint64 idItem, action_e& action2ForAll);
+
+    /**
+       @brief Commit the items written so far by save()
+
+       If the commit fails the batch is rolled back by rollbackBatch() and the
+       error is kept in errorCommit.
+
+       @param restart   start a new transaction for the next items
+       @return True on success.
+     */
+    bool commitBatch(bool restart = true);
+
+    /// roll back the items written since the last commit and restore their state before the write
+    void rollbackBatch();
+
+    /// remember the state of an item before it is written as part of the current batch
+    void addToBatch(IGisItem * item, const QString& hashInDb);
+
     QSqlDatabase db;
     quint64 id = 0;
+    bool inTransaction = false; ///< true while save() writes items in a transaction
+
+    struct batch_item_t
+    {
+        IGisItem * item;
+        QString hash;   ///< the item's hash in the database before the write
+        quint32 marks;  ///< the decoration marks before the write
+    };
+
+    /// the items written since the last commit
+    QList<batch_item_t> batch;
+    /// the error of the last failed commit
+    QString errorCommit;
 
     enum reasons_e
     {
@@ -156,6 +204,7 @@ protected:
         , eReasonQueryFail  = -1
         , eReasonUnexpected = -2
         , eReasonConflict   = -3
+        , eReasonCommitFail = -4
     };
 
     Qt::CheckState checkState = Qt::Unchecked;
@@ -32,6 +32,7 @@ CExportDatabase::CExportDatabase(quint64 id, QSqlDatabase &db, QWidget *parent)
     cfg.beginGroup("ExportDB");
     labelPath->setText(cfg.value("path", "-").toString());
     checkGpx11->setChecked(cfg.value("asGpx11", false).toBool());
+    checkParallel->setChecked(cfg.value("parallel", true).toBool());
     cfg.endGroup();
 
     QDir dir(labelPath->text());
@@ -54,6 +55,7 @@ CExportDatabase::~CExportDatabase()
     cfg.beginGroup("ExportDB");
     cfg.setValue("path", labelPath->text());
     cfg.setValue("asGpx11", checkGpx11->isChecked());
+    cfg.setValue("parallel", checkParallel->isChecked());
     cfg.endGroup();
 }
 
@@ -100,7 +102,7 @@ void CExportDatabase::slotSetPath()
 void CExportDatabase::slotStart()
 {
     textBrowser->clear();
-    thread->start(labelPath->text(), checkGpx11->isChecked());
+    thread->start(labelPath->text(), checkGpx11->isChecked(), checkParallel->isChecked());
 }
 
 void CExportDatabase::slotStarted()
@@ -20,12 +20,16 @@
 #include "gis/CGisWorkspace.h"
 #include "gis/db/CDBProject.h"
 #include "gis/db/CExportDatabaseThread.h"
+#include "gis/db/CExportDatabaseWorker.h"
+#include "gis/db/IDB.h"
 #include "gis/db/IDBFolder.h"
 #include "gis/db/macros.h"
 #include "gis/gpx/CGpxProject.h"
 
 #include <QtSql>
 
+#define EXPORT_MAX_THREADS 4
+
 CExportDatabaseThread::CExportDatabaseThread(quint64 id, QSqlDatabase &db, QObject *parent)
     : QThread(parent)
     , parentFolderId(id)
@@ -34,7 +38,7 @@ CExportDatabaseThread::CExportDatabaseThread(quint64 id, QSqlDatabase &db, QObje
 }
 
 
-void CExportDatabaseThread::start(const QString& path, bool saveAsGpx11)
+void CExportDatabaseThread::start(const QString& path, bool saveAsGpx11, bool parallel)
 {
     if(isRunning())
     {
@@ -42,6 +46,7 @@ void CExportDatabaseThread::start(const QString& path, bool saveAsGpx11)
     }
 
     asGpx11 = saveAsGpx11;
+    asParallel = parallel;
     exportPath = path;
     QThread::start();
 }
@@ -56,6 +61,8 @@ void CExportDatabaseThread::slotAbort()
 {
     QMutexLocker lock(&mutex);
     keepGoing = false;
+    waitJobs.wakeAll();
+    waitResults.wakeAll();
 }
 
 bool CExportDatabaseThread::getKeepGoing() const
@@ -68,7 +75,24 @@ void CExportDatabaseThread::run()
 {
     {
         QMutexLocker lock(&mutex);
-        keepGoing = true;
+        keepGoing   = true;
+        producing   = true;
+        cntJobs     = 0;
+        nextResult  = 0;
+        jobs.clear();
+        results.clear();
+    }
+
+    QList<CExportDatabaseWorker*> workers;
+    if(asParallel)
+    {
+        const int N = qBound(1, QThread::idealThreadCount(), EXPORT_MAX_THREADS);
+        for(int i = 0; i < N; i++)
+        {
+            CExportDatabaseWorker * worker = new CExportDatabaseWorker(i, dbParent, *this);
+            worker->start();
+            workers << worker;
+        }
     }
 
     try
@@ -95,6 +119,16 @@ void CExportDatabaseThread::run()
 
         dumpFolder(parentFolderId, "", exportPath, db);
 
+        if(asParallel)
+        {
+            {
+                QMutexLocker lock(&mutex);
+                producing = false;
+                waitJobs.wakeAll();
+            }
+            flushResults(true);
+        }
+
         emit sigOut(tr("Done!"));
         db.close();
     }
@@ -103,6 +137,20 @@ void CExportDatabaseThread::run()
         emit sigErr(msg);
     }
 
+    // stop all workers. Jobs not taken yet are dropped.
+    {
+        QMutexLocker lock(&mutex);
+        keepGoing = false;
+        producing = false;
+        waitJobs.wakeAll();
+    }
+    for(CExportDatabaseWorker * worker : workers)
+    {
+        worker->wait();
+    }
+    qDeleteAll(workers);
+
+    IDB::clearCached("tmp_export");
     QSqlDatabase::removeDatabase("tmp_export");
 }
 
@@ -144,30 +192,21 @@ void CExportDatabaseThread::dumpFolder(quint64 id, const QString& parentName, co
     else
     {
         // if it is a project or other folder dump it to a GPX file
-        const QString connectionName = db.connectionName();
-        CDBProject prj(connectionName, id, 0);
-
-        CEvtD2WShowItems evt(id, connectionName);
-        query.prepare("SELECT id, type FROM items WHERE id IN (SELECT child FROM folder2item WHERE parent=:parent)");
-        query.bindValue(":parent", id);
-        QUERY_EXEC(throw tr("Database Error: %1").arg(query.lastError().text()));
-        while(query.next())
+        job_t job;
+        job.id          = id;
+        job.type        = type;
+        job.parentName  = parentName;
+        job.path        = dir.absolutePath();
+
+        if(asParallel)
         {
-            quint64 itemId      = query.value(0).toULongLong();
-            quint32 itemType    = query.value(1).toUInt();
-            evt.items << evt_item_t(itemId, itemType);
+            addJob(job);
+            flushResults(false);
         }
-        prj.showItems(&evt);
-
-        QString simplifiedProjName = simplifyString(prj.getName());
-
-        // use simplified project name as filename. If the folder is of type "other" prepend it with the parent folder's name.
-        QString filename = dir.absoluteFilePath((!parentName.isEmpty() && (type == IDBFolder::eTypeOther)) ?  parentName + "_" + simplifiedProjName : simplifiedProjName) + ".gpx";
-        sigOut(tr("Save project as %1").arg(filename));
-
-        if(!CGpxProject::saveAs(filename,  prj, asGpx11))
+        else
         {
-            throw tr("Failed!");
+            QString filename;
+            exportProject(job, db, filename);
         }
     }
 
@@ -182,3 +221,106 @@ void CExportDatabaseThread::dumpFolder(quint64 id, const QString& parentName, co
         dumpFolder(childId, simplifiedName, dir.absolutePath(), db);
     }
 }
+
+void CExportDatabaseThread::exportProject(const job_t& job, QSqlDatabase& db, QString& filename)
+{
+    QDir dir(job.path);
+
+    const QString connectionName = db.connectionName();
+    CDBProject prj(connectionName, job.id, 0);
+
+    CEvtD2WShowItems evt(job.id, connectionName);
+    QSqlQuery query(db);
+    query.prepare("SELECT id, type FROM items WHERE id IN (SELECT child FROM folder2item WHERE parent=:parent)");
+    query.bindValue(":parent", job.id);
+    QUERY_EXEC(throw tr("Database Error: %1").arg(query.lastError().text()));
+    while(query.next())
+    {
+        quint64 itemId      = query.value(0).toULongLong();
+        quint32 itemType    = query.value(1).toUInt();
+        evt.items << evt_item_t(itemId, itemType);
+    }
+    prj.showItems(&evt);
+
+    QString simplifiedProjName = simplifyString(prj.getName());
+
+    // use simplified project name as filename. If the folder is of type "other" prepend it with the parent folder's name.
+    filename = dir.absoluteFilePath((!job.parentName.isEmpty() && (job.type == IDBFolder::eTypeOther)) ?  job.parentName + "_" + simplifiedProjName : simplifiedProjName) + ".gpx";
+    if(!asParallel)
+    {
+        // in parallel mode the export thread reports in the order of the jobs
+        emit sigOut(tr("Save project as %1").arg(filename));
+    }
+
+    if(!CGpxProject::saveAs(filename,  prj, asGpx11))
+    {
+        throw tr("Failed!");
+    }
+}
+
+void CExportDatabaseThread::addJob(job_t& job)
+{
+    QMutexLocker lock(&mutex);
+    job.idx = cntJobs++;
+    jobs.enqueue(job);
+    waitJobs.wakeOne();
+}
+
+bool CExportDatabaseThread::takeJob(job_t& job)
+{
+    QMutexLocker lock(&mutex);
+    while(keepGoing && producing && jobs.isEmpty())
+    {
+        waitJobs.wait(&mutex);
+    }
+
+    if(!keepGoing || jobs.isEmpty())
+    {
+        return false;
+    }
+
+    job = jobs.dequeue();
+    return true;
+}
+
+void CExportDatabaseThread::finishJob(const job_t& job, const QString& filename, const QString& error)
+{
+    QMutexLocker lock(&mutex);
+    result_t& result = results[job.idx];
+    result.filename = filename;
+    result.error    = error;
+    waitResults.wakeAll();
+}
+
+void CExportDatabaseThread::flushResults(bool block)
+{
+    QMutexLocker lock(&mutex);
+    while(nextResult < cntJobs)
+    {
+        if(!keepGoing)
+        {
+            throw tr("Abort by user!");
+        }
+
+        if(!results.contains(nextResult))
+        {
+            if(!block)
+            {
+                break;
+            }
+            waitResults.wait(&mutex);
+            continue;
+        }
+
+        const result_t result = results.take(nextResult++);
+        if(!result.filename.isEmpty())
+        {
+            emit sigOut(tr("Save project as %1").arg(result.filename));
+        }
+
+        if(!result.error.isEmpty())
+        {
+            throw result.error;
+        }
+    }
+}
@@ -19,18 +19,39 @@
 #ifndef CEXPORTDATABASETHREAD_H
 #define CEXPORTDATABASETHREAD_H
 
+#include <QMap>
 #include <QMutex>
+#include <QQueue>
 #include <QSqlDatabase>
 #include <QThread>
+#include <QWaitCondition>
 
 class CExportDatabaseThread : public QThread
 {
     Q_OBJECT
 public:
+    /// a project to be exported
+    struct job_t
+    {
+        /// running number of the job to keep the output in order
+        qint32 idx = 0;
+        quint64 id = 0;
+        quint32 type = 0;
+        QString parentName;
+        QString path;
+    };
+
     CExportDatabaseThread(quint64 id, QSqlDatabase& db, QObject * parent);
     virtual ~CExportDatabaseThread() = default;
 
-    void start(const QString& path, bool saveAsGpx11);
+    /**
+       @brief Start the export
+
+       @param path          the path to export to
+       @param saveAsGpx11   true to write GPX 1.1 without extensions
+       @param parallel      true to export the projects by several worker threads
+     */
+    void start(const QString& path, bool saveAsGpx11, bool parallel);
 
 public slots:
     void slotAbort();
@@ -45,16 +66,49 @@ protected:
     void dumpFolder(quint64 id, const QString &parentName, const QString& path, QSqlDatabase& db);
 
 private:
+    friend class CExportDatabaseWorker;
+
+    struct result_t
+    {
+        QString filename;
+        QString error;
+    };
+
     QString simplifyString(const QString &str) const;
+    /// load a project from the database and save it as GPX file. Throws a QString on error
+    void exportProject(const job_t& job, QSqlDatabase& db, QString& filename);
+
+    /// queue a job for the workers
+    void addJob(job_t& job);
+    /// called by the workers to get the next job. Blocks until a job is available. Returns false if there are no more jobs.
+    bool takeJob(job_t& job);
+    /// called by the workers to report the result of a job
+    void finishJob(const job_t& job, const QString& filename, const QString& error);
+    /// report all results available in the order of the jobs. If block is true wait for all jobs to finish.
+    void flushResults(bool block);
 
     mutable QMutex mutex;
     bool keepGoing = false;
 
+    /// wake up workers waiting for a job
+    QWaitCondition waitJobs;
+    /// wake up the export thread waiting for results
+    QWaitCondition waitResults;
+    QQueue<job_t> jobs;
+    QMap<qint32, result_t> results;
+    /// true as long as the folder tree is walked to produce jobs
+    bool producing = false;
+    /// number of jobs produced so far
+    qint32 cntJobs = 0;
+    /// index of the next job to report
+    qint32 nextResult = 0;
+
     quint64 parentFolderId;
     /// database connection from the main thread
     QSqlDatabase& dbParent;
     QString exportPath;
     bool asGpx11 = false;
+    bool asParallel = false;
 };
 
 #endif //CEXPORTDATABASETHREAD_H
@@ -0,0 +1,70 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "gis/db/CExportDatabaseThread.h"
+#include "gis/db/CExportDatabaseWorker.h"
+#include "gis/db/IDB.h"
+
+#include <QtSql>
+
+CExportDatabaseWorker::CExportDatabaseWorker(int no, QSqlDatabase &db, CExportDatabaseThread &master)
+    : QThread(nullptr)
+    , no(no)
+    , dbParent(db)
+    , master(master)
+{
+}
+
+void CExportDatabaseWorker::run()
+{
+    const QString connectionName = QString("tmp_export_%1").arg(no);
+    {
+        QSqlDatabase db = QSqlDatabase::cloneDatabase(dbParent, connectionName);
+
+        QString error;
+        if(!db.open())
+        {
+            error = tr("Failed to open database for export. \"%1\"").arg(db.lastError().text());
+        }
+
+        CExportDatabaseThread::job_t job;
+        while(master.takeJob(job))
+        {
+            QString filename;
+            // without a database connection every job fails with the same error
+            if(error.isEmpty())
+            {
+                try
+                {
+                    master.exportProject(job, db, filename);
+                }
+                catch(const QString& msg)
+                {
+                    master.finishJob(job, filename, msg);
+                    continue;
+                }
+            }
+
+            master.finishJob(job, filename, error);
+        }
+
+        IDB::clearCached(connectionName);
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
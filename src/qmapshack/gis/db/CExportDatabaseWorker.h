@@ -0,0 +1,55 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CEXPORTDATABASEWORKER_H
+#define CEXPORTDATABASEWORKER_H
+
+#include <QSqlDatabase>
+#include <QThread>
+
+class CExportDatabaseThread;
+
+/**
+   @brief Export projects handed out by CExportDatabaseThread in parallel
+
+   Each worker uses its own clone of the database connection. It takes
+   jobs from the export thread until there are no more jobs or the
+   export is aborted. The result of each job is reported back to the
+   export thread which publishes the results in the order of the jobs.
+ */
+class CExportDatabaseWorker : public QThread
+{
+    Q_OBJECT
+public:
+    CExportDatabaseWorker(int no, QSqlDatabase& db, CExportDatabaseThread& master);
+    virtual ~CExportDatabaseWorker() = default;
+
+protected:
+    void run() override;
+
+private:
+    /// the number of the worker, used to name the database connection
+    int no;
+    /// database connection from the main thread
+    QSqlDatabase& dbParent;
+    /// the thread producing the jobs
+    CExportDatabaseThread& master;
+};
+
+#endif //CEXPORTDATABASEWORKER_H
+
@@ -16,11 +16,10 @@
 
 **********************************************************************************************/
 
+#include "canvas/CCanvas.h"
+#include "CMainWindow.h"
 #include "gis/CGisListDB.h"
 #include "gis/CGisWorkspace.h"
-#include "gis/db/CDBFolderGroup.h"
-#include "gis/db/CDBFolderOther.h"
-#include "gis/db/CDBFolderProject.h"
 #include "gis/db/CDBItem.h"
 #include "gis/db/CSearchDatabase.h"
 #include "gis/db/IDBFolder.h"
@@ -29,6 +28,9 @@
 #include <QtSql>
 #include <QtWidgets>
 
+/// number of IDs passed in a single `IN (...)` list
+#define SEARCH_BATCH_SIZE 500
+
 CSearchDatabase::CSearchDatabase(IDBFolder &dbFolder, CGisListDB *parent)
     : QDialog(parent)
     , dbFolder(dbFolder)
@@ -38,6 +40,7 @@ CSearchDatabase::CSearchDatabase(IDBFolder &dbFolder, CGisListDB *parent)
     labelName->setText(tr("Search database '%1':").arg(dbFolder.getDBName()));
 
     connect(pushSearch, &QPushButton::clicked, this, &CSearchDatabase::slotSearch);
+    connect(pushSearchArea, &QPushButton::clicked, this, &CSearchDatabase::slotSearchArea);
     connect(pushClose, &QPushButton::clicked, this, &CSearchDatabase::accept);
     connect(treeResult, &QTreeWidget::itemChanged, this, &CSearchDatabase::slotItemChanged);
 }
@@ -77,25 +80,62 @@ void CSearchDatabase::slotItemChanged(QTreeWidgetItem * item, int column)
 }
 
 void CSearchDatabase::slotSearch()
+{
+    QSqlQuery query(dbFolder.getDb());
+    dbFolder.search(lineQuery->text(), query);
+
+    showResult(query);
+}
+
+void CSearchDatabase::slotSearchArea()
+{
+    CCanvas * canvas = CMainWindow::self().getVisibleCanvas();
+    if(nullptr == canvas)
+    {
+        return;
+    }
+
+    // the bounding box of all four corners covers the
+    // visible area even for rotated projections
+    const QRectF& rect = canvas->rect();
+    QPolygonF corners;
+    corners << rect.topLeft() << rect.topRight() << rect.bottomRight() << rect.bottomLeft();
+    for(QPointF& pt : corners)
+    {
+        canvas->convertPx2Rad(pt);
+    }
+
+    QSqlQuery query(dbFolder.getDb());
+    dbFolder.searchArea(corners.boundingRect(), query);
+
+    showResult(query);
+}
+
+void CSearchDatabase::showResult(QSqlQuery& query)
 {
     internalEdit = true;
 
     treeResult->clear();
 
     QSqlDatabase& db = dbFolder.getDb();
-    QSqlQuery query(db);
-    dbFolder.search(lineQuery->text(), query);
-
-    QMap<quint64, IDBFolder*> folders;
 
+    QList<quint64> itemIds;
     while(query.next())
     {
-        quint64 itemId = query.value(0).toULongLong();
+        itemIds << query.value(0).toULongLong();
+    }
 
+    // resolve the parent folders of all hits, a batch of items per query
+    QList<QPair<quint64, quint64> > item2folder;
+    QMap<quint64, folder_t> folderInfo;
+    QList<quint64> folderIds;
+
+    for(int i = 0; i < itemIds.size(); i += SEARCH_BATCH_SIZE)
+    {
         QSqlQuery query2(db);
-        query2.prepare("SELECT t1.id, t1.type FROM folders AS t1 WHERE id=(SELECT parent FROM folder2item WHERE child=:id)");
-        query2.bindValue(":id", itemId);
-        if(!query2.exec())
+        QString sql = "SELECT t1.child, t2.id, t2.type FROM folder2item AS t1, folders AS t2 "
+                      "WHERE t2.id=t1.parent AND t1.child IN (" + joinIds(itemIds.mid(i, SEARCH_BATCH_SIZE)) + ")";
+        if(!query2.exec(sql))
         {
             qWarning() << query2.lastQuery();
             qWarning() << query2.lastError();
@@ -104,98 +144,152 @@ void CSearchDatabase::slotSearch()
 
         while(query2.next())
         {
-            quint64 folderId = query2.value(0).toULongLong();
-            quint32 type = query2.value(1).toUInt();
-
-            IDBFolder * folder = nullptr;
-
-            if(!folders.contains(folderId))
-            {
-                switch(type)
-                {
-                case IDBFolder::eTypeProject:
-                    folder = new CDBFolderProject(db, folderId, 0);
-                    break;
-
-                case IDBFolder::eTypeOther:
-                    folder = new CDBFolderOther(db, folderId, 0);
-                    break;
+            quint64 itemId   = query2.value(0).toULongLong();
+            quint64 folderId = query2.value(1).toULongLong();
+            quint32 type     = query2.value(2).toUInt();
 
-                default:
-                    continue;
-                }
-
-                folders[folderId] = folder;
+            item2folder << qMakePair(itemId, folderId);
 
-                addWithParentFolders(treeResult, folder, folders, db);
-            }
-            else
+            if(!folderInfo.contains(folderId))
             {
-                folder = folders[folderId];
+                folderInfo[folderId].type = type;
+                folderIds << folderId;
             }
-
-            CDBItem * item = new CDBItem(db, itemId, folder);
-            item->setCheckState(CGisListDB::eColumnCheckbox, Qt::Unchecked);
         }
     }
 
-    treeResult->expandAll();
-    treeResult->header()->resizeSections(QHeaderView::ResizeToContents);
-
-    internalEdit = false;
-}
-
-void CSearchDatabase::addWithParentFolders(QTreeWidget * result, IDBFolder * child, QMap<quint64, IDBFolder*>& folders, QSqlDatabase& db)
-{
-    QSqlQuery query(db);
-
-    query.prepare("SELECT t1.id, t1.type FROM folders AS t1 WHERE id=(SELECT parent FROM folder2folder WHERE child=:id)");
-    query.bindValue(":id", child->getId());
-    QUERY_EXEC(return );
-
-    while(query.next())
+    // walk up the folder tree, one query per level for all folders of that level
+    while(!folderIds.isEmpty())
     {
-        quint64 folderId = query.value(0).toULongLong();
-        quint32 type = query.value(1).toUInt();
+        QList<quint64> parentIds;
 
-        if(!folders.contains(folderId))
+        for(int i = 0; i < folderIds.size(); i += SEARCH_BATCH_SIZE)
         {
-            IDBFolder * folder = nullptr;
-
-            switch(type)
+            QSqlQuery query2(db);
+            QString sql = "SELECT t1.child, t2.id, t2.type FROM folder2folder AS t1, folders AS t2 "
+                          "WHERE t2.id=t1.parent AND t1.child IN (" + joinIds(folderIds.mid(i, SEARCH_BATCH_SIZE)) + ")";
+            if(!query2.exec(sql))
             {
-            case IDBFolder::eTypeProject:
-                folder = new CDBFolderProject(db, folderId, 0);
-                break;
+                qWarning() << query2.lastQuery();
+                qWarning() << query2.lastError();
+                continue;
+            }
 
-            case IDBFolder::eTypeOther:
-                folder = new CDBFolderOther(db, folderId, 0);
-                break;
+            while(query2.next())
+            {
+                quint64 childId  = query2.value(0).toULongLong();
+                quint64 folderId = query2.value(1).toULongLong();
+                quint32 type     = query2.value(2).toUInt();
 
-            case IDBFolder::eTypeGroup:
-                folder = new CDBFolderGroup(db, folderId, 0);
-                break;
+                // A tree item can have a single parent only. The result shows
+                // a folder with several parents below the first one found.
+                if(folderInfo[childId].parent != 0)
+                {
+                    continue;
+                }
+                folderInfo[childId].parent = folderId;
 
-            default:
-                ;
+                if(!folderInfo.contains(folderId))
+                {
+                    folderInfo[folderId].type = type;
+                    parentIds << folderId;
+                }
             }
+        }
+
+        folderIds = parentIds;
+    }
+
+    // create all folders found above, a batch of folders per query
+    QMap<quint64, IDBFolder*> folders;
+    const QList<quint64> allFolderIds = folderInfo.keys();
+    for(int i = 0; i < allFolderIds.size(); i += SEARCH_BATCH_SIZE)
+    {
+        QSqlQuery query2(db);
+        QString sql = "SELECT t1.id, t1.keyqms, t1.name, t1.comment, t1.sortmode, "
+                      "(SELECT COUNT(*) FROM folder2folder WHERE parent=t1.id), "
+                      "(SELECT COUNT(*) FROM folder2item WHERE parent=t1.id) "
+                      "FROM folders AS t1 WHERE t1.id IN (" + joinIds(allFolderIds.mid(i, SEARCH_BATCH_SIZE)) + ")";
+        if(!query2.exec(sql))
+        {
+            qWarning() << query2.lastQuery();
+            qWarning() << query2.lastError();
+            continue;
+        }
 
+        while(query2.next())
+        {
+            quint64 folderId   = query2.value(0).toULongLong();
+            IDBFolder * folder = IDBFolder::createFolderByType(db, folderInfo[folderId].type, query2, nullptr);
             if(folder != nullptr)
             {
                 folders[folderId] = folder;
-                folder->addChild(child);
-                addWithParentFolders(result, folder, folders, db);
-            }
-            else
-            {
-                result->addTopLevelItem(child);
             }
         }
+    }
+
+    // build the folder tree. Folders without a parent in the result are top level items.
+    for(IDBFolder * folder : folders)
+    {
+        const quint64 parentId = folderInfo[folder->getId()].parent;
+        if(folders.contains(parentId))
+        {
+            folders[parentId]->addChild(folder);
+        }
         else
         {
-            folders[folderId]->addChild(child);
+            treeResult->addTopLevelItem(folder);
+        }
+    }
+
+    // add the items to their folders, a batch of items per query
+    QMultiHash<quint64, IDBFolder*> item2parents;
+    for(const QPair<quint64, quint64>& hit : item2folder)
+    {
+        const quint32 type = folderInfo[hit.second].type;
+        if(folders.contains(hit.second) && (type == IDBFolder::eTypeProject || type == IDBFolder::eTypeOther))
+        {
+            item2parents.insert(hit.first, folders[hit.second]);
+        }
+    }
+
+    const QList<quint64> hitIds = item2parents.uniqueKeys();
+    for(int i = 0; i < hitIds.size(); i += SEARCH_BATCH_SIZE)
+    {
+        QSqlQuery query2(db);
+        QString sql = "SELECT id, type, keyqms, icon, name, date, trash FROM items WHERE id IN (" + joinIds(hitIds.mid(i, SEARCH_BATCH_SIZE)) + ")";
+        if(!query2.exec(sql))
+        {
+            qWarning() << query2.lastQuery();
+            qWarning() << query2.lastError();
+            continue;
         }
+
+        while(query2.next())
+        {
+            // an item linked to several folders is shown in each of them
+            for(IDBFolder * folder : item2parents.values(query2.value(0).toULongLong()))
+            {
+                CDBItem * item = new CDBItem(db, query2, folder);
+                item->setCheckState(CGisListDB::eColumnCheckbox, Qt::Unchecked);
+            }
+        }
+    }
+
+    treeResult->expandAll();
+    treeResult->header()->resizeSections(QHeaderView::ResizeToContents);
+
+    internalEdit = false;
+}
+
+QString CSearchDatabase::joinIds(const QList<quint64>& ids)
+{
+    QStringList list;
+    for(quint64 id : ids)
+    {
+        list << QString::number(id);
     }
+    return list.join(",");
 }
 
 bool CSearchDatabase::event(QEvent * e)
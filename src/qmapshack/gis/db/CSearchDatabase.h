@@ -25,6 +25,7 @@
 class CGisListDB;
 class IDBFolder;
 class QSqlDatabase;
+class QSqlQuery;
 
 class CSearchDatabase : public QDialog, private Ui::ISearchDatabase
 {
@@ -40,10 +41,20 @@ signals:
 
 private slots:
     void slotSearch();
+    void slotSearchArea();
     void slotItemChanged(QTreeWidgetItem * item, int column);
 
 private:
-    void addWithParentFolders(QTreeWidget * result, IDBFolder * folder, QMap<quint64, IDBFolder *> &folders, QSqlDatabase &sqlDB);
+    /// type and parent folder of a folder found while resolving a search result
+    struct folder_t
+    {
+        quint32 type = 0;
+        quint64 parent = 0; //< 0 if there is no parent folder
+    };
+
+    /// fill the result tree with the item IDs in the query and their parent folders
+    void showResult(QSqlQuery& query);
+    static QString joinIds(const QList<quint64>& ids);
     void updateFolder(IDBFolder * folder, CEvtW2DAckInfo * evt);
     IDBFolder& dbFolder;
 
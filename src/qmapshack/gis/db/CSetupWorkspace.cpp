@@ -21,9 +21,12 @@
 #include "config.h"
 #include "gis/CGisWorkspace.h"
 #include "gis/db/CSetupWorkspace.h"
+#include "gis/qms/CQmsCodec.h"
 #include "helpers/CSettings.h"
 #include <QtWidgets>
 
+QVariantList CSetupWorkspace::startupSettings;
+
 CSetupWorkspace::CSetupWorkspace(CGisWorkspace * workspace, QWidget *parent)
     : QDialog(parent), workspace(workspace)
 {
@@ -38,8 +41,19 @@ CSetupWorkspace::CSetupWorkspace(CGisWorkspace * workspace, QWidget *parent)
     checkDeviceSupport->setChecked(cfg.value("device support", true).toBool());
     cfg.endGroup();
 
+    for(int i = 0; i < CQmsCodec::eCodecCount; i++)
+    {
+        comboCodec->addItem(CQmsCodec::getName(CQmsCodec::codec_e(i)), i);
+    }
+    comboCodec->setCurrentIndex(comboCodec->findData(CQmsCodec::getCodec()));
+
     checkShowTags->setChecked(!workspace->areTagsHidden());
 
+    if(startupSettings.isEmpty())
+    {
+        startupSettings = getStartupSettings();
+    }
+
     connect(checkSaveOnExit, &QCheckBox::toggled, spinSaveEvery, &QSpinBox::setEnabled);
 }
 
@@ -47,8 +61,21 @@ CSetupWorkspace::~CSetupWorkspace()
 {
 }
 
+QVariantList CSetupWorkspace::getStartupSettings() const
+{
+    QVariantList settings;
+    settings << checkSaveOnExit->isChecked()
+             << spinSaveEvery->value()
+             << checkDbUpdate->isChecked()
+             << linePort->text()
+             << checkDeviceSupport->isChecked();
+    return settings;
+}
+
 void CSetupWorkspace::accept()
 {
+    const bool needsRestart = getStartupSettings() != startupSettings;
+
     SETTINGS;
     cfg.beginGroup("Database");
     cfg.setValue("saveOnExit", checkSaveOnExit->isChecked());
@@ -56,11 +83,18 @@ void CSetupWorkspace::accept()
     cfg.setValue("listenUpdate", checkDbUpdate->isChecked());
     cfg.setValue("port", linePort->text());
     cfg.setValue("device support", checkDeviceSupport->isChecked());
+    cfg.setValue("codec", comboCodec->currentData());
     cfg.endGroup();
 
+    // the codec is used right away
+    CQmsCodec::setCodec(CQmsCodec::codec_e(comboCodec->currentData().toInt()));
+
     workspace->setTagsHidden(!checkShowTags->isChecked());
 
-    QMessageBox::information(this, tr("Setup database..."), tr("Changes to database settings will become active after an application's restart."), QMessageBox::Ok);
+    if(needsRestart)
+    {
+        QMessageBox::information(this, tr("Setup database..."), tr("Changes to database settings will become active after an application's restart."), QMessageBox::Ok);
+    }
 
     QDialog::accept();
 }
@@ -37,7 +37,16 @@ public slots:
     void accept() override;
 
 private:
+    /// get the settings read on startup only, in the state shown by the dialog
+    QVariantList getStartupSettings() const;
+
     CGisWorkspace * workspace;
+
+    /**
+       The settings read on startup only, as shown by the first dialog. As no one
+       else writes them, they are the ones the application is running with.
+     */
+    static QVariantList startupSettings;
 };
 
 #endif //CSETUPWORKSPACE_H
@@ -20,10 +20,14 @@
 #include "gis/db/IDB.h"
 #include "gis/db/macros.h"
 
+#include <proj_api.h>
 #include <QtSql>
 #include <QtWidgets>
 
 QMap<QString, int> IDB::references;
+QMutex IDB::mutexCached;
+QHash<QString, QHash<QString, QSqlQuery> > IDB::cachedStatements;
+QSet<QString> IDB::openTransactions;
 
 IDB::IDB()
 {
@@ -32,10 +36,14 @@ IDB::IDB()
 IDB::~IDB()
 {
     references[db.connectionName()]--;
-    if(references[db.connectionName()] == 0 && db.isOpen())
+    if(references[db.connectionName()] == 0)
     {
-        qDebug() << "close database" << db.connectionName();
-        db.close();
+        clearCached(db.connectionName());
+        if(db.isOpen())
+        {
+            qDebug() << "close database" << db.connectionName();
+            db.close();
+        }
     }
 }
 
@@ -120,19 +128,155 @@ bool IDB::setupDB(QString &error)
     return true;
 }
 
-quint64 IDB::getLastInsertID(QSqlDatabase& db, const QString& table)
+quint64 IDB::getLastInsertID(QSqlDatabase& db)
 {
     QSqlQuery query(db);
 
+    // both functions return the ID of the connection's last insert. Selecting them
+    // from a table would return a row for each row of the table.
     if(db.driverName() == "QSQLITE")
     {
-        QUERY_RUN("SELECT last_insert_rowid() from " + table, return 0)
+        QUERY_RUN("SELECT last_insert_rowid()", return 0)
     }
     else if(db.driverName() == "QMYSQL")
     {
-        QUERY_RUN("SELECT last_insert_id() from " + table, return 0)
+        QUERY_RUN("SELECT last_insert_id()", return 0)
     }
 
     query.next();
     return query.value(0).toULongLong();
 }
+
+void IDB::prepareCached(QSqlDatabase& db, QSqlQuery& query, const QString& sql)
+{
+    if(db.driverName() != "QMYSQL")
+    {
+        query.prepare(sql);
+        return;
+    }
+
+    QMutexLocker lock(&mutexCached);
+    QHash<QString, QSqlQuery>& statements = cachedStatements[db.connectionName()];
+    if(!statements.contains(sql))
+    {
+        QSqlQuery statement(db);
+        if(!statement.prepare(sql))
+        {
+            // don't keep the failed statement. The error will
+            // be reported by the caller's attempt to execute it.
+            query.prepare(sql);
+            return;
+        }
+        statements.insert(sql, statement);
+    }
+
+    // QSqlQuery is implicitly shared. Both objects use the same prepared statement.
+    query = statements[sql];
+}
+
+bool IDB::execCached(QSqlDatabase& db, QSqlQuery& query)
+{
+    if(query.exec())
+    {
+        return true;
+    }
+
+    if(db.driverName() != "QMYSQL")
+    {
+        return false;
+    }
+
+    const QString sql = query.lastQuery();
+    const QMap<QString, QVariant> values = query.boundValues();
+
+    clearCached(db.connectionName());
+
+    {
+        QMutexLocker lock(&mutexCached);
+        if(openTransactions.contains(db.connectionName()))
+        {
+            return false;
+        }
+    }
+
+    prepareCached(db, query, sql);
+    for(const QString& placeholder : values.keys())
+    {
+        query.bindValue(placeholder, values[placeholder]);
+    }
+
+    return query.exec();
+}
+
+void IDB::clearCached(const QString& connectionName)
+{
+    QMutexLocker lock(&mutexCached);
+    cachedStatements.remove(connectionName);
+}
+
+bool IDB::transaction(QSqlDatabase& db)
+{
+    if(!db.transaction())
+    {
+        return false;
+    }
+
+    QMutexLocker lock(&mutexCached);
+    openTransactions.insert(db.connectionName());
+    return true;
+}
+
+bool IDB::commit(QSqlDatabase& db)
+{
+    {
+        QMutexLocker lock(&mutexCached);
+        openTransactions.remove(db.connectionName());
+    }
+    return db.commit();
+}
+
+bool IDB::rollback(QSqlDatabase& db)
+{
+    {
+        QMutexLocker lock(&mutexCached);
+        openTransactions.remove(db.connectionName());
+    }
+    return db.rollback();
+}
+
+void IDB::updateItemArea(QSqlDatabase& db, quint64 idItem, const QRectF& area)
+{
+    if(area == QRectF())
+    {
+        // items without any coordinates are not part of the spatial index
+        return;
+    }
+
+    const QRectF& rect = area.normalized();
+    const qreal west   = rect.left()   * RAD_TO_DEG;
+    const qreal east   = rect.right()  * RAD_TO_DEG;
+    const qreal south  = rect.top()    * RAD_TO_DEG;
+    const qreal north  = rect.bottom() * RAD_TO_DEG;
+
+    QSqlQuery query(db);
+
+    if(db.driverName() == "QSQLITE")
+    {
+        query.prepare("INSERT OR REPLACE INTO itemarea (id, west, east, south, north) VALUES (:id, :west, :east, :south, :north)");
+    }
+    else if(db.driverName() == "QMYSQL")
+    {
+        prepareCached(db, query, "REPLACE INTO itemarea (id, west, east, south, north) VALUES (:id, :west, :east, :south, :north)");
+    }
+    else
+    {
+        return;
+    }
+
+    query.bindValue(":id",    idItem);
+    query.bindValue(":west",  west);
+    query.bindValue(":east",  east);
+    query.bindValue(":south", south);
+    query.bindValue(":north", north);
+    QUERY_EXEC_CACHED(return );
+}
@@ -20,8 +20,13 @@
 #define IDB_H
 
 #include <QCoreApplication>
+#include <QHash>
 #include <QMap>
+#include <QMutex>
+#include <QRectF>
+#include <QSet>
 #include <QSqlDatabase>
+#include <QSqlQuery>
 
 class IDB
 {
@@ -33,7 +38,76 @@ public:
 
     QSqlDatabase& getDb() { return db; }
 
-    static quint64 getLastInsertID(QSqlDatabase& db, const QString& table);
+    /**
+       @brief Get the ID of the last row inserted via the connection
+
+       @param db        the database connection
+       @return The ID or 0 on failure
+     */
+    static quint64 getLastInsertID(QSqlDatabase& db);
+
+    /**
+       @brief Prepare a statement and keep it for later use on the same connection
+
+       For MySQL each prepare() costs a round trip to the server. Statements used
+       for every item, e.g. while saving a project, are prepared once per
+       connection and shared by all queries using them. SQLite statements are
+       prepared as usual, as this is cheap and unfinished statements would hold
+       a lock on the database file.
+
+       @note The result set is shared with all other queries of the same statement.
+             It has to be read before the statement is executed again.
+
+       @param db        the database connection
+       @param query     the query to share the prepared statement
+       @param sql       the SQL statement
+     */
+    static void prepareCached(QSqlDatabase& db, QSqlQuery& query, const QString& sql);
+
+    /**
+       @brief Execute a query prepared by prepareCached()
+
+       The MySQL client reconnects silently after the server dropped the connection
+       (e.g. after `wait_timeout`). All statements prepared before are gone on the
+       server then. If the execution fails, the statements of the connection are
+       dropped and the query is prepared and executed once more with the same values.
+
+       There is no second attempt while a transaction started by transaction() is
+       open. A reconnect has dropped the transaction on the server and the statement
+       would be executed outside of it.
+
+       @param db        the database connection
+       @param query     the query prepared by prepareCached()
+
+       @return The result of QSqlQuery::exec()
+     */
+    static bool execCached(QSqlDatabase& db, QSqlQuery& query);
+
+    /// drop all statements kept by prepareCached() for a connection
+    static void clearCached(const QString& connectionName);
+
+    /**
+       @brief Start a transaction on the connection
+
+       @param db        the database connection
+       @return The result of QSqlDatabase::transaction()
+     */
+    static bool transaction(QSqlDatabase& db);
+
+    /// commit the transaction started by transaction()
+    static bool commit(QSqlDatabase& db);
+
+    /// roll back the transaction started by transaction()
+    static bool rollback(QSqlDatabase& db);
+
+    /**
+       @brief Store the bounding box of an item in the spatial index table `itemarea`
+
+       @param db        the database connection
+       @param idItem    the item's ID in the database
+       @param area      the item's bounding box [rad] as returned by IGisItem::getBoundingRect()
+     */
+    static void updateItemArea(QSqlDatabase& db, quint64 idItem, const QRectF& area);
 
     bool isUsable() const
     {
@@ -42,6 +116,11 @@ public:
 
 protected:
     static QMap<QString, int> references;
+
+    static QMutex mutexCached;
+    static QHash<QString, QHash<QString, QSqlQuery> > cachedStatements;
+    static QSet<QString> openTransactions;  ///< the connections with a transaction started by transaction()
+
     QSqlDatabase db;
     void setup(const QString& connectionName);
     bool setupDB(QString &error);
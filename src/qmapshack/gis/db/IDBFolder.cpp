@@ -83,6 +83,24 @@ IDBFolder * IDBFolder::createFolderByType(QSqlDatabase& db, int type, quint64 id
     }
 }
 
+IDBFolder * IDBFolder::createFolderByType(QSqlDatabase& db, int type, const QSqlQuery& query, QTreeWidgetItem * parent)
+{
+    switch(type)
+    {
+    case eTypeGroup:
+        return new CDBFolderGroup(db, query, parent);
+
+    case eTypeProject:
+        return new CDBFolderProject(db, query, parent);
+
+    case eTypeOther:
+        return new CDBFolderOther(db, query, parent);
+
+    default:
+        return nullptr;
+    }
+}
+
 QString IDBFolder::getNameEx(const QString& dbName, quint64 id)
 {
     QString name;
@@ -201,7 +219,7 @@ quint64 IDBFolder::addFolderToDb(type_e type, const QString& name, quint64 idPar
     query.bindValue(":type", type);
     QUERY_EXEC(return 0);
 
-    quint64 idChild = IDB::getLastInsertID(db, "folders");
+    quint64 idChild = IDB::getLastInsertID(db);
     if(idChild == 0)
     {
         qDebug() << "CGisListDB::slotAddFolder(): childId equals 0. bad.";
@@ -454,6 +472,23 @@ void IDBFolder::setupFromDB()
     // check if folder has child folders (to set expand indicator)
     setChildIndicator();
 
+    setupCheckBox();
+}
+
+void IDBFolder::setupFromQuery(const QSqlQuery& query)
+{
+    key = query.value(1).toString();
+    setText(CGisListDB::eColumnName, query.value(2).toString());
+    setToolTip(CGisListDB::eColumnName, query.value(3).toString());
+    sortMode = query.value(4).toUInt();
+
+    setChildIndicator(query.value(5).toInt(), showItems() ? query.value(6).toInt() : 0);
+
+    setupCheckBox();
+}
+
+void IDBFolder::setupCheckBox()
+{
     // If the folder is loadable the checkbox has to be displayed and
     // an event to query the state has to be sent to the workspace.
     if(isLoadable && showCheckBoxes())
@@ -486,62 +521,30 @@ void IDBFolder::addChildren(const QSet<QString>& activeChildren, bool showFolder
 
     if(showItems)
     {
-        QList<CDBItem*> items;
-        // tracks 2nd
-        query.prepare("SELECT t1.child FROM folder2item AS t1, items AS t2 WHERE t1.parent = :id AND t2.id = t1.child AND t2.type=:type ORDER BY t2.id");
-        query.bindValue(":id", id);
-        query.bindValue(":type", IGisItem::eTypeTrk);
-        QUERY_EXEC(return );
-        while(query.next())
-        {
-            quint64 idChild = query.value(0).toULongLong();
-            CDBItem * item = new CDBItem(db, idChild, nullptr);
-            item->setCheckState(CGisListDB::eColumnCheckbox, activeChildren.contains(item->getKey()) ? Qt::Checked : Qt::Unchecked);
-            items << item;
-        }
-        addItemsSorted(items);
+        // read all items of the folder at once, the way they are shown:
+        // tracks 2nd, routes 3rd, waypoints 4th and overlays 5th
+        const QList<int> types = {IGisItem::eTypeTrk, IGisItem::eTypeRte, IGisItem::eTypeWpt, IGisItem::eTypeOvl};
+        QHash<int, QList<CDBItem*> > items;
 
-        // routes 3rd
-        query.prepare("SELECT t1.child FROM folder2item AS t1, items AS t2 WHERE t1.parent = :id AND t2.id = t1.child AND t2.type=:type ORDER BY t2.id");
+        query.prepare("SELECT t2.id, t2.type, t2.keyqms, t2.icon, t2.name, t2.date, t2.trash FROM folder2item AS t1, items AS t2 WHERE t1.parent = :id AND t2.id = t1.child ORDER BY t2.id");
         query.bindValue(":id", id);
-        query.bindValue(":type", IGisItem::eTypeRte);
         QUERY_EXEC(return );
         while(query.next())
         {
-            quint64 idChild = query.value(0).toULongLong();
-            CDBItem * item = new CDBItem(db, idChild, nullptr);
-            item->setCheckState(CGisListDB::eColumnCheckbox, activeChildren.contains(item->getKey()) ? Qt::Checked : Qt::Unchecked);
-            items << item;
-        }
-        addItemsSorted(items);
+            if(!types.contains(query.value(1).toInt()))
+            {
+                continue;
+            }
 
-        //waypoints 4th
-        query.prepare("SELECT t1.child FROM folder2item AS t1, items AS t2 WHERE t1.parent = :id AND t2.id = t1.child AND t2.type=:type ORDER BY t2.id");
-        query.bindValue(":id", id);
-        query.bindValue(":type", IGisItem::eTypeWpt);
-        QUERY_EXEC(return );
-        while(query.next())
-        {
-            quint64 idChild = query.value(0).toULongLong();
-            CDBItem * item = new CDBItem(db, idChild, nullptr);
+            CDBItem * item = new CDBItem(db, query, nullptr);
             item->setCheckState(CGisListDB::eColumnCheckbox, activeChildren.contains(item->getKey()) ? Qt::Checked : Qt::Unchecked);
-            items << item;
+            items[item->getType()] << item;
         }
-        addItemsSorted(items);
 
-        // overlays 5th
-        query.prepare("SELECT t1.child FROM folder2item AS t1, items AS t2 WHERE t1.parent = :id AND t2.id = t1.child AND t2.type=:type ORDER BY t2.id");
-        query.bindValue(":id", id);
-        query.bindValue(":type", IGisItem::eTypeOvl);
-        QUERY_EXEC(return );
-        while(query.next())
+        for(int type : types)
         {
-            quint64 idChild = query.value(0).toULongLong();
-            CDBItem * item = new CDBItem(db, idChild, nullptr);
-            item->setCheckState(CGisListDB::eColumnCheckbox, activeChildren.contains(item->getKey()) ? Qt::Checked : Qt::Unchecked);
-            items << item;
+            addItemsSorted(items[type]);
         }
-        addItemsSorted(items);
     }
 }
 
@@ -609,6 +612,11 @@ void IDBFolder::setChildIndicator()
         nItems = query.value(0).toInt();
     }
 
+    setChildIndicator(nFolders, nItems);
+}
+
+void IDBFolder::setChildIndicator(qint32 nFolders, qint32 nItems)
+{
     // set indicator according to items
     if(nFolders || nItems)
     {
@@ -623,10 +631,15 @@ void IDBFolder::setChildIndicator()
 void IDBFolder::addItemsSorted(QList<CDBItem*>& items)
 {
     sortItems(items);
+
+    // adding all items in one go is much faster than adding them one by one
+    QList<QTreeWidgetItem*> children;
+    children.reserve(items.size());
     for(CDBItem * item : items)
     {
-        addChild(item);
+        children << item;
     }
+    QTreeWidgetItem::addChildren(children);
     items.clear();
 }
 
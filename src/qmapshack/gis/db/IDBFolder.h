@@ -25,6 +25,7 @@
 #include <QTreeWidgetItem>
 
 class QSqlDatabase;
+class QSqlQuery;
 class CEvtW2DAckInfo;
 class IDBFolderSql;
 class CDBItem;
@@ -143,6 +144,20 @@ public:
      */
     static IDBFolder * createFolderByType(QSqlDatabase &db, int type, quint64 id, QTreeWidgetItem *parent);
 
+    /**
+     * @brief Create a new treeWidgetItem from a row of a query
+     *
+     * Used to create many folders with a single query. See setupFromQuery()
+     * for the columns needed.
+     *
+     * @param db        the database the item belongs to
+     * @param type      the folder type to create
+     * @param query     the query positioned at the folder's row
+     * @param parent    the items parent item
+     * @return A pointer to the new treewidgetitem.
+     */
+    static IDBFolder * createFolderByType(QSqlDatabase &db, int type, const QSqlQuery& query, QTreeWidgetItem *parent);
+
     /**
        @brief Get name extended by parent folders and database name
 
@@ -170,6 +185,20 @@ public:
         return false;
     }
 
+    /**
+       @brief Search for all items with a bounding box intersecting the given area.
+
+       Like search() this must be overridden by the database folder classes. The
+       query will contain a list of item IDs.
+
+       @param area      The area to search in [rad]
+       @param query     The sql query item to use
+     */
+    virtual bool searchArea(const QRectF& area, QSqlQuery& query)
+    {
+        return false;
+    }
+
     bool isSiblingFrom(IDBFolder * folder) const;
 
     void exportToGpx();
@@ -186,6 +215,18 @@ protected:
      */
     virtual void setupFromDB();
 
+    /**
+       @brief Setup all item properties from a query instead of reading them
+
+       Does the same as setupFromDB(). The query has to be positioned at a row
+       with the columns `id, keyqms, name, comment, sortmode`, the number of
+       child folders and the number of child items.
+     */
+    void setupFromQuery(const QSqlQuery& query);
+
+    /// show the checkbox of loadable folders and ask the workspace for the folder's state
+    void setupCheckBox();
+
     /**
        @brief Add child items like folders, tracks, routes, waypoints and overlays
 
@@ -208,6 +249,7 @@ protected:
     virtual void remove(quint64 idParent, quint64 idFolder);
 
     void setChildIndicator();
+    void setChildIndicator(qint32 nFolders, qint32 nItems);
 
     void addItemsSorted(QList<CDBItem *> &items);
     void sortItems(QList<CDBItem *> &items) const;
@@ -171,7 +171,7 @@ bool IDBMysql::initDB()
               "WHERE id=OLD.child AND OLD.child NOT IN(SELECT child FROM folder2item);"
               , return false);
 
-    return true;
+    return createItemAreaTable();
 }
 
 bool IDBMysql::migrateDB(int version)
@@ -195,6 +195,22 @@ bool IDBMysql::migrateDB(int version)
                 throw -1;
             }
         }
+
+        if(version < 7)
+        {
+            // creates the spatial index in the layout of version 8 already
+            if(!migrateDB6to7())
+            {
+                throw -1;
+            }
+        }
+        else if(version < 8)
+        {
+            if(!migrateDB7to8())
+            {
+                throw -1;
+            }
+        }
     }
     catch(int i)
     {
@@ -316,3 +332,84 @@ bool IDBMysql::migrateDB5to6()
     return true;
 }
 
+bool IDBMysql::migrateDB6to7()
+{
+    QSqlQuery query(db);
+
+    if(!createItemAreaTable())
+    {
+        return false;
+    }
+
+    // get number of items in the database
+    QUERY_RUN("SELECT Count(*) FROM items", return false);
+    query.next();
+    quint32 N = query.value(0).toUInt();
+
+    // over all items
+    QUERY_RUN("SELECT id, type FROM items", return false);
+    PROGRESS_SETUP(tr("Update to database version 7. Build spatial index."), 0, N, CMainWindow::self().getBestWidgetForParent());
+    progress.enableCancel(false);
+    quint32 cnt = 0;
+    while(query.next())
+    {
+        PROGRESS(cnt++,;
+                 );
+
+        quint64 itemId      = query.value(0).toULongLong();
+        quint32 itemType    = query.value(1).toUInt();
+        IGisItem *item      = IGisItem::newGisItem(itemType, itemId, db, nullptr);
+
+        if(nullptr == item)
+        {
+            continue;
+        }
+
+        updateItemArea(db, itemId, item->getBoundingRect());
+
+        delete item;
+    }
+
+    return true;
+}
+
+bool IDBMysql::migrateDB7to8()
+{
+    QSqlQuery query(db);
+
+    // Version 7 used a GEOMETRY column with a spatial index. MySQL 8.0 and
+    // later ignore that index, as the column has no SRID attribute.
+    QUERY_RUN("DROP TRIGGER itemarea_delete", return false);
+    QUERY_RUN("DROP TABLE itemarea", return false);
+
+    // create and fill the table in its new layout
+    return migrateDB6to7();
+}
+
+bool IDBMysql::createItemAreaTable()
+{
+    QSqlQuery query(db);
+
+    /*
+        The bounding box is stored as plain columns with the same layout
+        as SQLite's fallback table. A spatial index on a GEOMETRY column
+        would need a SRID attribute for MySQL 8.0 and later, but MariaDB
+        and older MySQL servers do not know that attribute.
+     */
+    QUERY_RUN( "CREATE TABLE itemarea ("
+               "id             INTEGER PRIMARY KEY,"
+               "west           REAL NOT NULL,"
+               "east           REAL NOT NULL,"
+               "south          REAL NOT NULL,"
+               "north          REAL NOT NULL,"
+               "INDEX itemarea_west_east (west, east),"
+               "INDEX itemarea_south_north (south, north)"
+               ")", return false);
+
+    QUERY_RUN("CREATE TRIGGER itemarea_delete "
+              "AFTER DELETE ON items "
+              "FOR EACH ROW DELETE FROM itemarea WHERE id=OLD.id;"
+              , return false);
+
+    return true;
+}
@@ -35,6 +35,12 @@ protected:
     bool migrateDB(int version) override;
     bool migrateDB4to5();
     bool migrateDB5to6();
+    bool migrateDB6to7();
+    bool migrateDB7to8();
+
+private:
+    /// create the spatial index table `itemarea` and its trigger
+    bool createItemAreaTable();
 };
 
 #endif //IDBMYSQL_H
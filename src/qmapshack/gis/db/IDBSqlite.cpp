@@ -169,6 +169,12 @@ bool IDBSqlite::initDB()
                   "INSERT INTO searchindex(id, comment) VALUES(NEW.id, NEW.comment); "
                   "END;", throw -1);
 
+        // create table with spatial index
+        if(!createItemAreaTable())
+        {
+            throw -1;
+        }
+
         QUERY_RUN("END TRANSACTION;", throw -1);
     }
     catch(int i)
@@ -231,6 +237,16 @@ bool IDBSqlite::migrateDB(int version)
             }
         }
 
+        if(version < 7)
+        {
+            if(!migrateDB6to7())
+            {
+                throw -1;
+            }
+        }
+
+        // version 8 changed the spatial index of MySQL databases only
+
         QUERY_RUN("END TRANSACTION;", throw -1);
     }
     catch(int i)
@@ -487,3 +503,72 @@ bool IDBSqlite::migrateDB5to6()
     return true;
 }
 
+bool IDBSqlite::migrateDB6to7()
+{
+    QSqlQuery query(db);
+
+    if(!createItemAreaTable())
+    {
+        return false;
+    }
+
+    // get number of items in the database
+    QUERY_RUN("SELECT Count(*) FROM items", return false);
+    query.next();
+    quint32 N = query.value(0).toUInt();
+
+    // over all items
+    QUERY_RUN("SELECT id, type FROM items", return false);
+    PROGRESS_SETUP(tr("Update to database version 7. Build spatial index."), 0, N, CMainWindow::self().getBestWidgetForParent());
+    progress.enableCancel(false);
+    quint32 cnt = 0;
+    while(query.next())
+    {
+        PROGRESS(cnt++,;
+                 );
+
+        quint64 idItem      = query.value(0).toULongLong();
+        quint32 typeItem    = query.value(1).toUInt();
+
+        IGisItem *item = IGisItem::newGisItem(typeItem, idItem, db, nullptr);
+
+        if(nullptr == item)
+        {
+            continue;
+        }
+
+        updateItemArea(db, idItem, item->getBoundingRect());
+
+        delete item;
+    }
+
+    return true;
+}
+
+bool IDBSqlite::createItemAreaTable()
+{
+    QSqlQuery query(db);
+
+    if(!query.exec("CREATE VIRTUAL TABLE itemarea USING rtree(id, west, east, south, north)"))
+    {
+        qWarning() << "SQLite has no R*Tree module. Use plain table as spatial index.";
+
+        QUERY_RUN("CREATE TABLE itemarea ("
+                  "id             INTEGER PRIMARY KEY NOT NULL,"
+                  "west           REAL NOT NULL,"
+                  "east           REAL NOT NULL,"
+                  "south          REAL NOT NULL,"
+                  "north          REAL NOT NULL"
+                  ")", return false);
+
+        QUERY_RUN("CREATE INDEX itemarea_west_east ON itemarea (west, east)", return false);
+        QUERY_RUN("CREATE INDEX itemarea_south_north ON itemarea (south, north)", return false);
+    }
+
+    QUERY_RUN("CREATE TRIGGER itemarea_delete "
+              "AFTER DELETE ON items BEGIN "
+              "DELETE FROM itemarea WHERE id=OLD.id; "
+              "END;", return false);
+
+    return true;
+}
@@ -38,6 +38,19 @@ protected:
     bool migrateDB3to4();
     bool migrateDB4to5();
     bool migrateDB5to6();
+    bool migrateDB6to7();
+
+private:
+    /**
+       @brief Create the spatial index table `itemarea` and its trigger
+
+       The table is an R*Tree virtual table. If SQLite has been built without
+       the R*Tree module a plain table with indices on the coordinates is used
+       instead. Both are queried with the same SQL statement.
+
+       @return True on success.
+     */
+    bool createItemAreaTable();
 };
 
 #endif //IDBSQLITE_H
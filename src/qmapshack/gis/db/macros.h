@@ -19,7 +19,7 @@
 #ifndef MACROS_H
 #define MACROS_H
 
-#define DB_VERSION 6
+#define DB_VERSION 8
 
 #define NO_CMD ((void)0)
 
@@ -31,6 +31,15 @@
         cmd; \
     }
 
+// same as QUERY_EXEC() for a query prepared by IDB::prepareCached()
+#define QUERY_EXEC_CACHED(cmd) \
+    if(!IDB::execCached(db, query)) \
+    { \
+        qWarning() << "Execution of SQL-Statement `" << query.lastQuery() << "` failed:"; \
+        qWarning() << query.lastError(); \
+        cmd; \
+    }
+
 #define QUERY_RUN(stmt, cmd) \
     if(!query.exec(stmt)) \
     { \
@@ -24,6 +24,7 @@
 #include "gis/ovl/CScrOptOvlArea.h"
 #include "gis/prj/IGisProject.h"
 #include "GeoMath.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CDraw.h"
 
 #include <proj_api.h>
@@ -262,7 +263,7 @@ void CGisItemOvlArea::deriveSecondaryData()
     area.area = qAbs(area.area / 2);
 }
 
-void CGisItemOvlArea::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis)
+void CGisItemOvlArea::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis)
 {
     QMutexLocker lock(&mutexItems);
 
@@ -309,7 +310,7 @@ void CGisItemOvlArea::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRe
     p.restore();
 }
 
-void CGisItemOvlArea::drawLabel(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis)
+void CGisItemOvlArea::drawLabel(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis)
 {
     QMutexLocker lock(&mutexItems);
 
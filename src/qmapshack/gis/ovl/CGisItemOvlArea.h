@@ -107,8 +107,8 @@ public:
     void edit() override;
 
     using IGisItem::drawItem;
-    void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis) override;
-    void drawLabel(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) override;
+    void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis) override;
+    void drawLabel(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) override;
     void drawHighlight(QPainter& p) override;
 
     IScrOpt * getScreenOptions(const QPoint &origin, IMouse * mouse) override;
@@ -350,6 +350,7 @@ void IGisProject::setAutoSave(bool on)
 void IGisProject::setAutoSyncToDevice(bool yes)
 {
     autoSyncToDev = yes;
+    generation++;
     updateDecoration();
 }
 
@@ -363,6 +364,7 @@ void IGisProject::switchOnCorrelation()
 
 void IGisProject::updateItems()
 {
+    generation++;
     if(noUpdate)
     {
         return;
@@ -884,13 +886,15 @@ void IGisProject::insertCopyOfItem(IGisItem * item, int off, CSelectCopyAction::
     }
 }
 
-void IGisProject::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis)
+void IGisProject::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis)
 {
     if(!isVisible())
     {
         return;
     }
 
+    const bool clustered = wptClusters.draw(*this, p, viewport, blockedAreas, gis);
+
     for(int i = 0; i < childCount(); i++)
     {
         if(gis->needsRedraw())
@@ -904,6 +908,11 @@ void IGisProject::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
             continue;
         }
 
+        if(clustered && wptClusters.contains(item))
+        {
+            continue;
+        }
+
         item->drawItem(p, viewport, blockedAreas, gis);
     }
 }
@@ -928,7 +937,7 @@ void IGisProject::drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis)
     }
 }
 
-void IGisProject::drawLabel(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis)
+void IGisProject::drawLabel(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis)
 {
     if(!isVisible())
     {
@@ -1008,6 +1017,8 @@ bool IGisProject::remove()
 
 void IGisProject::updateItemCounters()
 {
+    wptClusters.invalidate();
+
     // count number of items by type
     memset(cntItemsByType, 0, sizeof(cntItemsByType));
     cntTrkPts = 0;
@@ -1235,6 +1246,8 @@ void IGisProject::applyFilters()
 
         item->setHidden(!(projectFilterResult && workspaceFilterResult));//get search result returns wether the object matches
     }
+
+    wptClusters.invalidate();
 }
 
 bool IGisProject::findPolylineCloseBy(const QPointF& pt1, const QPointF& pt2, qint32& threshold, QPolygonF& polyline)
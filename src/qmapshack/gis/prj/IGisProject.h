@@ -24,6 +24,7 @@
 #include "gis/rte/router/IRouter.h"
 #include "gis/search/CProjectFilterItem.h"
 #include "gis/search/CSearch.h"
+#include "gis/wpt/CWptClusters.h"
 #include "helpers/CSelectCopyAction.h"
 #include <QDebug>
 #include <QMessageBox>
@@ -455,8 +456,22 @@ public:
      */
     bool isChanged() const;
 
-    void drawItem(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, CGisDraw * gis);
-    void drawLabel(QPainter& p, const QPolygonF &viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis);
+    /**
+       @brief Get the change generation of the project
+
+       The generation is increased with every change of the project's items or
+       metadata. It is used to detect projects that need to be written again
+       when the workspace is saved.
+
+       @return The number of changes since the project has been created
+     */
+    quint32 getGeneration() const
+    {
+        return generation;
+    }
+
+    void drawItem(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, CGisDraw * gis);
+    void drawLabel(QPainter& p, const QPolygonF &viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis);
     void drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis);
 
     /**
@@ -528,6 +543,14 @@ public:
         return noUpdate;
     }
 
+    /**
+       @brief Drop the waypoint clusters. They are rebuilt with the next draw.
+     */
+    void invalidateWptClusters()
+    {
+        wptClusters.invalidate();
+    }
+
     void setProjectFilter(const CSearch& search);
     void setWorkspaceFilter(const CSearch& search);
     void applyFilters();
@@ -618,6 +641,7 @@ protected:
     bool invalidDataOk          = false; ///< if set invalid data in GIS items will not raise any dialog
     bool autoSyncToDev          = false; ///< if set true sync the project with every device connected
     bool autoSyncToDevPending   = false; ///< flag to show that a sync to device is already pending
+    quint32 generation          = 0;     ///< change counter, see getGeneration()
 
     metadata_t metadata;
     QString nameSuffix;
@@ -642,6 +666,8 @@ protected:
     CSearch workspaceSearch = CSearch("");
 
     CProjectFilterItem* projectFilter = nullptr;
+
+    CWptClusters wptClusters;
 };
 Q_DECLARE_METATYPE(IGisProject*)
 
@@ -0,0 +1,204 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "gis/qms/CQmsCodec.h"
+
+#include <QtCore>
+
+#define MAGIC_CODEC     "QMSC"
+#define MAGIC_CODEC_SIZE 4
+#define VER_CODEC       quint8(1)
+#define HEADER_SIZE     (MAGIC_CODEC_SIZE + 2)
+
+#define PREFETCH_MIN_SIZE    16
+#define PREFETCH_MAX_THREADS 4
+
+QAtomicInt CQmsCodec::codec(CQmsCodec::eCodecZlibFast);
+QMutex CQmsCodec::mutexPrefetched;
+QHash<QByteArray, QByteArray> CQmsCodec::prefetched;
+QAtomicInt CQmsCodec::cntPrefetched(0);
+
+class CQmsCodecWorker : public QThread
+{
+public:
+    CQmsCodecWorker(const QList<QByteArray>& data, QByteArray * results, QAtomicInt& next)
+        : data(data)
+        , results(results)
+        , next(next)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        // each thread takes the next index not processed so far
+        for(int i = next.fetchAndAddOrdered(1); i < data.size(); i = next.fetchAndAddOrdered(1))
+        {
+            results[i] = CQmsCodec::uncompressData(data.at(i));
+        }
+    }
+
+private:
+    const QList<QByteArray>& data;
+    QByteArray * results;
+    QAtomicInt& next;
+};
+
+void CQmsCodec::setCodec(codec_e c)
+{
+    if(c < 0 || c >= eCodecCount)
+    {
+        c = eCodecZlibFast;
+    }
+    codec.store(c);
+}
+
+QString CQmsCodec::getName(codec_e codec)
+{
+    switch(codec)
+    {
+    case eCodecZlibBest:
+        return tr("zlib, best compression");
+
+    case eCodecZlibFast:
+        return tr("zlib, fast compression");
+
+    case eCodecNone:
+        return tr("no compression");
+
+    default:
+        ;
+    }
+    return "-";
+}
+
+QByteArray CQmsCodec::compress(const QByteArray& data, codec_e codec)
+{
+    switch(codec)
+    {
+    case eCodecZlibBest:
+        return qCompress(data, 9);
+
+    case eCodecZlibFast:
+        return qCompress(data, 1);
+
+    default:
+        ;
+    }
+
+    QByteArray result;
+    result.reserve(HEADER_SIZE + data.size());
+    result.append(MAGIC_CODEC, MAGIC_CODEC_SIZE);
+    result.append(char(VER_CODEC));
+    result.append(char(eCodecNone));
+    result.append(data);
+    return result;
+}
+
+QByteArray CQmsCodec::uncompress(const QByteArray& data)
+{
+    if(cntPrefetched.load() > 0)
+    {
+        QMutexLocker lock(&mutexPrefetched);
+        QHash<QByteArray, QByteArray>::iterator it = prefetched.find(data);
+        if(it != prefetched.end())
+        {
+            QByteArray result = it.value();
+            prefetched.erase(it);
+            cntPrefetched.store(prefetched.size());
+            return result;
+        }
+    }
+
+    return uncompressData(data);
+}
+
+QByteArray CQmsCodec::uncompressData(const QByteArray& data)
+{
+    if(data.size() < HEADER_SIZE || !data.startsWith(MAGIC_CODEC) || quint8(data[MAGIC_CODEC_SIZE]) != VER_CODEC)
+    {
+        // data written by qCompress()
+        return qUncompress(data);
+    }
+
+    const quint8 c = quint8(data[MAGIC_CODEC_SIZE + 1]);
+    switch(c)
+    {
+    case eCodecZlibBest:
+    case eCodecZlibFast:
+        return qUncompress(data.mid(HEADER_SIZE));
+
+    case eCodecNone:
+        return data.mid(HEADER_SIZE);
+
+    default:
+        ;
+    }
+
+    qWarning() << "Unknown codec" << c << "in QMS data";
+    return QByteArray();
+}
+
+void CQmsCodec::prefetch(const QList<QByteArray>& data)
+{
+    const int nThreads = qMin(QThread::idealThreadCount(), PREFETCH_MAX_THREADS);
+    if(data.size() < PREFETCH_MIN_SIZE || nThreads < 2)
+    {
+        return;
+    }
+
+    QVector<QByteArray> results(data.size());
+    QAtomicInt next(0);
+
+    QList<CQmsCodecWorker*> workers;
+    for(int i = 0; i < nThreads; i++)
+    {
+        CQmsCodecWorker * worker = new CQmsCodecWorker(data, results.data(), next);
+        worker->start();
+        workers << worker;
+    }
+
+    for(CQmsCodecWorker * worker : workers)
+    {
+        worker->wait();
+    }
+    qDeleteAll(workers);
+
+    QMutexLocker lock(&mutexPrefetched);
+    for(int i = 0; i < data.size(); i++)
+    {
+        prefetched.insert(data[i], results[i]);
+    }
+    cntPrefetched.store(prefetched.size());
+}
+
+void CQmsCodec::prefetch(const QByteArray& data)
+{
+    const QByteArray result = uncompressData(data);
+
+    QMutexLocker lock(&mutexPrefetched);
+    prefetched.insert(data, result);
+    cntPrefetched.store(prefetched.size());
+}
+
+void CQmsCodec::clearPrefetched()
+{
+    QMutexLocker lock(&mutexPrefetched);
+    prefetched.clear();
+    cntPrefetched.store(0);
+}
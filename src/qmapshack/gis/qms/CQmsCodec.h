@@ -0,0 +1,116 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CQMSCODEC_H
+#define CQMSCODEC_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QHash>
+#include <QMutex>
+
+class CQmsCodecWorker;
+
+/**
+   @brief Compress the serialized data of items in QMS files and database blobs
+
+   The zlib codecs write the plain output of qCompress(). It's the format used
+   by all versions of QMapShack and can be read by older versions, too. All other
+   codecs are written into a small container:
+
+       "QMSC" | version (quint8) | codec (quint8) | payload
+
+   The magic can't be confused with data of qCompress(). Its 4 byte size field
+   would be followed by the zlib header (0x78) instead of the version.
+
+   The codec used to write data is a global setting. Reading detects the codec
+   from the data. All methods are thread safe.
+
+   Large batches of data, like all items of a project, can be uncompressed in
+   parallel by prefetch(). The results are kept until they are picked up by
+   uncompress() or dropped by clearPrefetched().
+ */
+class CQmsCodec
+{
+    Q_DECLARE_TR_FUNCTIONS(CQmsCodec)
+    friend class CQmsCodecWorker;
+public:
+    enum codec_e
+    {
+        eCodecZlibBest  = 0 //< zlib level 9, smallest size but slow
+        , eCodecZlibFast = 1 //< zlib level 1, about 3 times faster with slightly larger data
+        , eCodecNone     = 2 //< no compression at all
+        , eCodecCount
+    };
+
+    static void setCodec(codec_e codec);
+    static codec_e getCodec()
+    {
+        return codec_e(codec.load());
+    }
+
+    /// get a translated name of the codec for the GUI
+    static QString getName(codec_e codec);
+
+    /// compress data with the codec set by setCodec()
+    static QByteArray compress(const QByteArray& data)
+    {
+        return compress(data, getCodec());
+    }
+
+    static QByteArray compress(const QByteArray& data, codec_e codec);
+
+    /// uncompress data written by any of the codecs
+    static QByteArray uncompress(const QByteArray& data);
+
+    /**
+       @brief Uncompress a list of data with several threads
+
+       The call blocks until all data is uncompressed. Small lists are ignored
+       as the threads would cost more than they save.
+
+       @param data  a list of data as passed to uncompress() later on
+     */
+    static void prefetch(const QList<QByteArray>& data);
+
+    /**
+       @brief Uncompress data in the calling thread and keep the result for uncompress()
+
+       Used by threads loading items in the background. The result is
+       kept until it is picked up or dropped by clearPrefetched().
+
+       @param data  the data as passed to uncompress() later on
+     */
+    static void prefetch(const QByteArray& data);
+
+    /// drop all prefetched data not consumed by uncompress()
+    static void clearPrefetched();
+
+private:
+    static QByteArray uncompressData(const QByteArray& data);
+
+    static QAtomicInt codec;
+
+    static QMutex mutexPrefetched;
+    static QHash<QByteArray, QByteArray> prefetched;
+    static QAtomicInt cntPrefetched; //< lock free check for prefetched data
+};
+
+#endif //CQMSCODEC_H
+
@@ -20,6 +20,7 @@
 #include "gis/db/CDBProject.h"
 #include "gis/ovl/CGisItemOvlArea.h"
 #include "gis/prj/IGisProject.h"
+#include "gis/qms/CQmsCodec.h"
 #include "gis/rte/CGisItemRte.h"
 #include "gis/trk/CGisItemTrk.h"
 #include "gis/wpt/CGisItemWpt.h"
@@ -159,8 +160,63 @@ QDataStream& operator>>(QDataStream& stream, IGisItem::history_event_t& e)
     return stream;
 }
 
+void IGisItem::history_t::complete()
+{
+    if(isComplete())
+    {
+        return;
+    }
+
+    QList<QByteArray> data;
+    QDataStream in(&pendingData, QIODevice::ReadOnly);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setVersion(QDataStream::Qt_5_2);
+    in >> data;
+
+    const int N = qMin(data.size(), events.size());
+    for(int i = 0; i < N; i++)
+    {
+        // the current event and events cut from the history have no data
+        if(!data[i].isEmpty())
+        {
+            events[i].data = data[i];
+        }
+    }
+
+    pendingData.clear();
+}
+
+QByteArray IGisItem::history_t::getCurrentPayload() const
+{
+    if(histIdxCurrent < 0 || histIdxCurrent >= events.size())
+    {
+        return QByteArray();
+    }
+
+    QByteArray data = events[histIdxCurrent].data;
+    QDataStream in(&data, QIODevice::ReadOnly);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setVersion(QDataStream::Qt_5_2);
+
+    quint8 versionItem;
+    QByteArray buffer;
+    in.skipRawData(MAGIC_SIZE);
+    in >> versionItem;
+    in >> buffer;
+    return buffer;
+}
+
 QDataStream& operator<<(QDataStream& stream, const IGisItem::history_t& h)
 {
+    if(!h.isComplete())
+    {
+        // the stored format always has the data of all events
+        IGisItem::history_t history = h;
+        history.complete();
+        stream << history;
+        return stream;
+    }
+
     stream << VER_HIST;
     stream << h.histIdxInitial;
     stream << h.histIdxCurrent;
@@ -168,13 +224,100 @@ QDataStream& operator<<(QDataStream& stream, const IGisItem::history_t& h)
     return stream;
 }
 
+/*
+    Copy a serialized QByteArray from one stream to another. The data is
+    passed through the buffer in chunks, so no QByteArray is created for
+    each call and a corrupted size can't allocate huge amounts of memory.
+ */
+static void copyByteArray(QDataStream& in, QDataStream& out, QByteArray& buffer)
+{
+    quint32 size;
+    in >> size;
+    out << size;
+
+    // a null byte array has no data
+    if(size == 0xFFFFFFFF)
+    {
+        return;
+    }
+
+    while((size > 0) && (in.status() == QDataStream::Ok))
+    {
+        const int n = qMin(size, quint32(1024 * 1024));
+        buffer.resize(n);
+        if(in.readRawData(buffer.data(), n) != n)
+        {
+            in.setStatus(QDataStream::ReadPastEnd);
+            return;
+        }
+        out.writeRawData(buffer.constData(), n);
+        size -= n;
+    }
+}
+
 QDataStream& operator>>(QDataStream& stream, IGisItem::history_t& h)
 {
     quint8 version;
     stream >> version;
     stream >> h.histIdxInitial;
     stream >> h.histIdxCurrent;
-    stream >> h.events;
+
+    /*
+        The events are read one by one instead of as QList<history_event_t>.
+        Only the current event is read with its data, as this is all that is
+        needed to restore the item. The data of all other events is copied as
+        it is serialized into pendingData. history_t::complete() reads it when
+        it is needed. The stored format is the same as before, thus older
+        versions of QMapShack read it as usual.
+     */
+    quint32 N;
+    stream >> N;
+
+    const qint32 idxCurrent = qMin(h.histIdxCurrent, qint32(N) - 1);
+
+    QByteArray pendingData;
+    QDataStream out(&pendingData, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setVersion(QDataStream::Qt_5_2);
+    out << N;
+
+    bool hasPending = false;
+    QByteArray buffer;
+    h.events.clear();
+    for(quint32 i = 0; (i < N) && (stream.status() == QDataStream::Ok); i++)
+    {
+        IGisItem::history_event_t e;
+        if(qint32(i) == idxCurrent)
+        {
+            stream >> e;
+            out << QByteArray();
+        }
+        else
+        {
+            quint8 versionEvt;
+            stream >> versionEvt;
+            stream >> e.time;
+            stream >> e.icon;
+            stream >> e.comment;
+            copyByteArray(stream, out, buffer);
+            if(versionEvt > 1)
+            {
+                stream >> e.hash;
+            }
+            if(versionEvt > 2)
+            {
+                stream >> e.who;
+            }
+            hasPending = true;
+        }
+        h.events << e;
+    }
+
+    h.pendingData.clear();
+    if(hasPending)
+    {
+        h.pendingData = pendingData;
+    }
 
     if(h.histIdxCurrent >= h.events.size())
     {
@@ -191,12 +334,14 @@ QDataStream& operator>>(QDataStream& stream, IGisItem::history_t& h)
         h.histIdxInitial = NOIDX;
         h.histIdxCurrent = NOIDX;
         h.events.clear();
+        h.pendingData.clear();
     }
     if(h.histIdxInitial < 0)
     {
         h.histIdxInitial = NOIDX;
         h.histIdxCurrent = NOIDX;
         h.events.clear();
+        h.pendingData.clear();
     }
 
     return stream;
@@ -576,7 +721,7 @@ QDataStream& CGisItemTrk::operator>>(QDataStream& stream) const
 
     stream.writeRawData(MAGIC_TRK, MAGIC_SIZE);
     stream << VER_TRK;
-    stream << qCompress(buffer, 9);
+    stream << CQmsCodec::compress(buffer);
     return stream;
 }
 
@@ -600,7 +745,7 @@ QDataStream& CGisItemTrk::operator<<(QDataStream& stream)
 
     stream >> version;
     stream >> buffer;
-    buffer = qUncompress(buffer);
+    buffer = CQmsCodec::uncompress(buffer);
 
     QDataStream in(&buffer, QIODevice::ReadOnly);
     in.setByteOrder(QDataStream::LittleEndian);
@@ -701,7 +846,7 @@ QDataStream& CGisItemWpt::operator<<(QDataStream& stream)
 
     stream >> version;
     stream >> buffer;
-    buffer = qUncompress(buffer);
+    buffer = CQmsCodec::uncompress(buffer);
 
     QDataStream in(&buffer, QIODevice::ReadOnly);
     in.setByteOrder(QDataStream::LittleEndian);
@@ -759,7 +904,7 @@ QDataStream& CGisItemWpt::operator>>(QDataStream& stream) const
 
     stream.writeRawData(MAGIC_WPT, MAGIC_SIZE);
     stream << VER_WPT;
-    stream << qCompress(buffer, 9);
+    stream << CQmsCodec::compress(buffer);
 
     return stream;
 }
@@ -782,7 +927,7 @@ QDataStream& CGisItemRte::operator<<(QDataStream& stream)
 
     stream >> version;
     stream >> buffer;
-    buffer = qUncompress(buffer);
+    buffer = CQmsCodec::uncompress(buffer);
 
     QDataStream in(&buffer, QIODevice::ReadOnly);
     in.setByteOrder(QDataStream::LittleEndian);
@@ -853,7 +998,7 @@ QDataStream& CGisItemRte::operator>>(QDataStream& stream) const
 
     stream.writeRawData(MAGIC_RTE, MAGIC_SIZE);
     stream << VER_RTE;
-    stream << qCompress(buffer, 9);
+    stream << CQmsCodec::compress(buffer);
 
     return stream;
 }
@@ -876,7 +1021,7 @@ QDataStream& CGisItemOvlArea::operator<<(QDataStream& stream)
 
     stream >> version;
     stream >> buffer;
-    buffer = qUncompress(buffer);
+    buffer = CQmsCodec::uncompress(buffer);
 
     QDataStream in(&buffer, QIODevice::ReadOnly);
     in.setByteOrder(QDataStream::LittleEndian);
@@ -938,7 +1083,7 @@ QDataStream& CGisItemOvlArea::operator>>(QDataStream& stream) const
 
     stream.writeRawData(MAGIC_AREA, MAGIC_SIZE);
     stream << VER_AREA;
-    stream << qCompress(buffer, 9);
+    stream << CQmsCodec::compress(buffer);
 
     return stream;
 }
@@ -1006,43 +1151,72 @@ QDataStream& IGisProject::operator<<(QDataStream& stream)
         sortingFolder = (sorting_folder_e)tmp;
     }
 
-    while(!stream.atEnd())
+    struct item_record_t
     {
-        QString lastDatabaseHash;
+        quint8 type;
+        quint8 changed;
         IGisItem::history_t history;
-        quint8 changed = 0;
-        quint8 version, type;
+        QString lastDatabaseHash;
+    };
+
+    QList<item_record_t> records;
+    while(!stream.atEnd())
+    {
+        item_record_t record;
+        record.changed = 0;
+        quint8 version;
         stream >> version;
-        stream >> type;
-        stream >> history;
+        stream >> record.type;
+        stream >> record.history;
         if(version > 1)
         {
-            stream >> changed;
+            stream >> record.changed;
         }
 
         if(version > 2)
         {
-            stream >> lastDatabaseHash;
+            stream >> record.lastDatabaseHash;
         }
 
+        records << record;
+    }
 
+    /*
+        Uncompressing the item data is the most expensive part of loading
+        a project. Do it for the current history event of all items in
+        parallel. The items are created below as usual and pick up the
+        prefetched data in their own operator<<.
+     */
+    QList<QByteArray> payloads;
+    for(const item_record_t& record : records)
+    {
+        const QByteArray buffer = record.history.getCurrentPayload();
+        if(!buffer.isEmpty())
+        {
+            payloads << buffer;
+        }
+    }
+    CQmsCodec::prefetch(payloads);
+
+    for(const item_record_t& record : records)
+    {
         IGisItem *item = nullptr;
-        switch(type)
+        switch(record.type)
         {
         case IGisItem::eTypeWpt:
-            item = new CGisItemWpt(history, lastDatabaseHash, this);
+            item = new CGisItemWpt(record.history, record.lastDatabaseHash, this);
             break;
 
         case IGisItem::eTypeTrk:
-            item = new CGisItemTrk(history, lastDatabaseHash, this);
+            item = new CGisItemTrk(record.history, record.lastDatabaseHash, this);
             break;
 
         case IGisItem::eTypeRte:
-            item = new CGisItemRte(history, lastDatabaseHash, this);
+            item = new CGisItemRte(record.history, record.lastDatabaseHash, this);
             break;
 
         case IGisItem::eTypeOvl:
-            item = new CGisItemOvlArea(history, lastDatabaseHash, this);
+            item = new CGisItemOvlArea(record.history, record.lastDatabaseHash, this);
             break;
 
         default:
@@ -1052,7 +1226,7 @@ QDataStream& IGisProject::operator<<(QDataStream& stream)
         //Update decoration always, to set possible rating and tag markers
         if(item)
         {
-            if(changed)
+            if(record.changed)
             {
                 item->updateDecoration(IGisItem::eMarkChanged, IGisItem::eMarkNone);
             }
@@ -1062,6 +1236,7 @@ QDataStream& IGisProject::operator<<(QDataStream& stream)
             }
         }
     }
+    CQmsCodec::clearPrefetched();
 
     sortItems();
 
@@ -29,6 +29,7 @@
 #include "gis/rte/CScrOptRte.h"
 #include "gis/trk/CGisItemTrk.h"
 #include "GeoMath.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CDraw.h"
 #include "helpers/CDraw.h"
 #include "helpers/CWptIconManager.h"
@@ -551,7 +552,7 @@ void CGisItemRte::looseUserFocus()
 
 
 
-void CGisItemRte::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF> &blockedAreas, CGisDraw *gis)
+void CGisItemRte::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas &blockedAreas, CGisDraw *gis)
 {
     QMutexLocker lock(&mutexItems);
 
@@ -701,7 +702,7 @@ void CGisItemRte::drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis)
     }
 }
 
-void CGisItemRte::drawLabel(QPainter& p, const QPolygonF& viewport, QList<QRectF> &blockedAreas, const QFontMetricsF &fm, CGisDraw *gis)
+void CGisItemRte::drawLabel(QPainter& p, const QPolygonF& viewport, CBlockedAreas &blockedAreas, const QFontMetricsF &fm, CGisDraw *gis)
 {
     QMutexLocker lock(&mutexItems);
     if(!isVisible(boundingRect, viewport, gis))
@@ -131,9 +131,9 @@ public:
     QString getInfo(quint32 feature) const override;
     IScrOpt * getScreenOptions(const QPoint &origin, IMouse * mouse) override;
     QPointF getPointCloseBy(const QPoint& screenPos) override;
-    void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis) override;
+    void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis) override;
     void drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis) override;
-    void drawLabel(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) override;
+    void drawLabel(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) override;
     void drawHighlight(QPainter& p) override;
     void save(QDomNode& gpx, bool strictGpx11) override;
     bool isCloseTo(const QPointF& pos) override;
@@ -30,6 +30,7 @@
 #include "gis/trk/CScrOptTrk.h"
 #include "gis/wpt/CGisItemWpt.h"
 #include "GeoMath.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CDraw.h"
 #include "helpers/CProgressDialog.h"
 #include "helpers/CSettings.h"
@@ -1870,7 +1871,7 @@ void CGisItemTrk::copySelectedPoints() const
     new CGisItemTrk(name, idx1, idx2, trk, project);
 }
 
-void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF> &blockedAreas, CGisDraw *gis)
+void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas &blockedAreas, CGisDraw *gis)
 {
     QMutexLocker lock(&mutexItems);
 
@@ -2070,7 +2071,7 @@ void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
 }
 
 
-void CGisItemTrk::drawLimitLabels(limit_type_e type, const QString& label, const QPointF& pos, QPainter& p, const QFontMetricsF& fm, QList<QRectF>& blockedAreas)
+void CGisItemTrk::drawLimitLabels(limit_type_e type, const QString& label, const QPointF& pos, QPainter& p, const QFontMetricsF& fm, CBlockedAreas& blockedAreas)
 {
     const QString& fullLabel = (type == eLimitTypeMin ? tr("min.") : tr("max.")) + " " + label;
     QRectF rect = fm.boundingRect(fullLabel);
@@ -2428,7 +2429,7 @@ void CGisItemTrk::drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis)
     drawRange(p, gis);
 }
 
-void CGisItemTrk::drawLabel(QPainter& p, const QPolygonF&, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw* gis)
+void CGisItemTrk::drawLabel(QPainter& p, const QPolygonF&, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw* gis)
 {
     if(!keyUserFocus.item.isEmpty() && (key != keyUserFocus))
     {
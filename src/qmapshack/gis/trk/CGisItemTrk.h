@@ -371,9 +371,9 @@ public:
 
     bool isWithin(const QRectF& area, selflags_t flags) override;
 
-    void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis) override;
+    void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis) override;
     void drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis) override;
-    void drawLabel(QPainter&p, const QPolygonF&, QList<QRectF>&blockedAreas, const QFontMetricsF&fm, CGisDraw*gis) override;
+    void drawLabel(QPainter&p, const QPolygonF&, CBlockedAreas&blockedAreas, const QFontMetricsF&fm, CGisDraw*gis) override;
     void drawHighlight(QPainter& p) override;
     void drawRange(QPainter& p, CGisDraw *gis);
 
@@ -726,7 +726,7 @@ private:
         eLimitTypeMin
         , eLimitTypeMax
     };
-    void drawLimitLabels(limit_type_e type, const QString &label, const QPointF& pos, QPainter& p, const QFontMetricsF &fm, QList<QRectF> &blockedAreas);
+    void drawLimitLabels(limit_type_e type, const QString &label, const QPointF& pos, QPainter& p, const QFontMetricsF &fm, CBlockedAreas &blockedAreas);
 
     /**
        @brief Tell the point of focus to all plots and the detail dialog
@@ -30,6 +30,7 @@
 #include "gis/wpt/CScrOptWptRadius.h"
 #include "gis/wpt/CSetupIconAndName.h"
 #include "GeoMath.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CDraw.h"
 #include "helpers/CSettings.h"
 #include "helpers/CWptIconManager.h"
@@ -186,6 +187,12 @@ CGisItemWpt::CGisItemWpt(CFitStream& stream, IGisProject * project)
 
 CGisItemWpt::~CGisItemWpt()
 {
+    // the clusters must not keep a pointer to this waypoint
+    IGisProject * project = getParentProject();
+    if(project)
+    {
+        project->invalidateWptClusters();
+    }
 }
 
 IGisItem * CGisItemWpt::createClone()
@@ -631,7 +638,7 @@ void CGisItemWpt::editInitial()
     squashHistory();
 }
 
-void CGisItemWpt::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF> &blockedAreas, CGisDraw *gis)
+void CGisItemWpt::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas &blockedAreas, CGisDraw *gis)
 {
     posScreen = QPointF(wpt.lon * DEG_TO_RAD, wpt.lat * DEG_TO_RAD);
 
@@ -694,7 +701,7 @@ void CGisItemWpt::drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis)
 }
 
 
-void CGisItemWpt::drawLabel(QPainter& p, const QPolygonF &viewport, QList<QRectF> &blockedAreas, const QFontMetricsF &fm, CGisDraw *gis)
+void CGisItemWpt::drawLabel(QPainter& p, const QPolygonF &viewport, CBlockedAreas &blockedAreas, const QFontMetricsF &fm, CGisDraw *gis)
 {
     if(flags & eFlagWptBubble)
     {
@@ -292,9 +292,9 @@ public:
 
     QPointF getPointCloseBy(const QPoint& point) override;
 
-    void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw * gis) override;
+    void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis) override;
     void drawItem(QPainter& p, const QRectF& viewport, CGisDraw * gis) override;
-    void drawLabel(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) override;
+    void drawLabel(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, const QFontMetricsF& fm, CGisDraw * gis) override;
     void drawHighlight(QPainter& p) override;
     bool isCloseTo(const QPointF& pos) override;
     bool isWithin(const QRectF &area, selflags_t flags) override;
@@ -344,6 +344,19 @@ public:
         hideArea = hide;
     }
 
+    /**
+       @brief Forget the position on the screen
+
+       Used for waypoints that are part of a cluster and not drawn as single
+       icon. Without a position on the screen neither label nor highlight are
+       drawn and the waypoint can't be selected by the mouse.
+     */
+    void resetScreenPos()
+    {
+        rectBubble = QRect();
+        posScreen  = NOPOINTF;
+    }
+
     void genKey() const override;
     const searchValue_t getValueByKeyword(searchProperty_e keyword) override;
 
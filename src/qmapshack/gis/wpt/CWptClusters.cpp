@@ -0,0 +1,206 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "gis/CGisDraw.h"
+#include "gis/prj/IGisProject.h"
+#include "gis/wpt/CGisItemWpt.h"
+#include "gis/wpt/CWptClusters.h"
+#include "helpers/CBlockedAreas.h"
+
+#include <QtWidgets>
+
+void CWptClusters::invalidate()
+{
+    valid = false;
+    active = false;
+    wpts.clear();
+    members.clear();
+    levels.clear();
+    singles.clear();
+}
+
+void CWptClusters::build(IGisProject& project)
+{
+    invalidate();
+    valid = true;
+
+    const int N = project.childCount();
+    for(int i = 0; i < N; i++)
+    {
+        CGisItemWpt * wpt = dynamic_cast<CGisItemWpt*>(project.child(i));
+        // waypoints with a radius or a bubble are drawn as they are
+        if(wpt == nullptr || wpt->isHidden() || wpt->hasRadius() || wpt->hasBubble())
+        {
+            continue;
+        }
+        wpts << wpt;
+    }
+
+    if(wpts.count() < MIN_WPTS)
+    {
+        wpts.clear();
+        return;
+    }
+
+    levels.resize(MAX_LEVEL + 1);
+    for(CGisItemWpt * wpt : wpts)
+    {
+        members << wpt;
+
+        const QPointF& pos = wpt->getPosition();
+        for(int level = 0; level <= MAX_LEVEL; level++)
+        {
+            const qreal size = 360.0 / (1 << level);
+            const qint32 x = qFloor((pos.x() + 180.0) / size);
+            const qint32 y = qFloor((pos.y() + 90.0) / size);
+
+            cell_t& cell = levels[level][key(x, y)];
+            if(cell.wpt == nullptr)
+            {
+                cell.wpt = wpt;
+            }
+            cell.count++;
+            cell.sum += pos;
+        }
+    }
+}
+
+void CWptClusters::resetScreenPos(bool all)
+{
+    if(all)
+    {
+        for(CGisItemWpt * wpt : wpts)
+        {
+            wpt->resetScreenPos();
+        }
+    }
+    else
+    {
+        for(CGisItemWpt * wpt : singles)
+        {
+            wpt->resetScreenPos();
+        }
+    }
+    singles.clear();
+}
+
+bool CWptClusters::draw(IGisProject& project, QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis)
+{
+    if(!valid)
+    {
+        build(project);
+    }
+
+    if(members.isEmpty())
+    {
+        return false;
+    }
+
+    // get the screen size of one degree at the center of the viewport
+    const QRectF& rectViewport = viewport.boundingRect();
+    QPointF pt1 = rectViewport.center() - QPointF(0.5 * DEG_TO_RAD, 0);
+    QPointF pt2 = rectViewport.center() + QPointF(0.5 * DEG_TO_RAD, 0);
+    gis->convertRad2Px(pt1);
+    gis->convertRad2Px(pt2);
+    const qreal pxPerDeg = QLineF(pt1, pt2).length();
+
+    // select the finest level with cells still larger than CELL_SIZE
+    const qreal cellsPerWorld = pxPerDeg * 360.0 / CELL_SIZE;
+    const int level = cellsPerWorld < 1 ? 0 : qFloor(std::log2(cellsPerWorld));
+    if(level > MAX_LEVEL || level < 0)
+    {
+        // close enough to draw all waypoints
+        active = false;
+        singles.clear();
+        return false;
+    }
+
+    // waypoints drawn previously must not keep their old screen position
+    resetScreenPos(!active);
+    active = true;
+
+    const QHash<quint64, cell_t>& cells = levels[level];
+    const qreal size = 360.0 / (1 << level);
+    const qint32 x1 = qFloor((rectViewport.left()   * RAD_TO_DEG + 180.0) / size);
+    const qint32 x2 = qFloor((rectViewport.right()  * RAD_TO_DEG + 180.0) / size);
+    const qint32 y1 = qFloor((rectViewport.top()    * RAD_TO_DEG + 90.0) / size);
+    const qint32 y2 = qFloor((rectViewport.bottom() * RAD_TO_DEG + 90.0) / size);
+
+    auto drawCell = [&](const cell_t& cell)
+    {
+        if(cell.count == 1)
+        {
+            cell.wpt->drawItem(p, viewport, blockedAreas, gis);
+            singles << cell.wpt;
+        }
+        else
+        {
+            QPointF pos = cell.sum / cell.count * DEG_TO_RAD;
+            gis->convertRad2Px(pos);
+            drawCluster(p, pos, cell.count, blockedAreas);
+        }
+    };
+
+    // iterate over whatever is less: the visible cells or the occupied cells
+    if(qreal(x2 - x1 + 1) * qreal(y2 - y1 + 1) < cells.size())
+    {
+        for(qint32 y = y1; y <= y2; y++)
+        {
+            for(qint32 x = x1; x <= x2; x++)
+            {
+                auto cell = cells.constFind(key(x, y));
+                if(cell != cells.constEnd())
+                {
+                    drawCell(*cell);
+                }
+            }
+        }
+    }
+    else
+    {
+        for(auto cell = cells.constBegin(); cell != cells.constEnd(); ++cell)
+        {
+            const qint32 x = qint32(cell.key() >> 32);
+            const qint32 y = qint32(cell.key() & 0xFFFFFFFF);
+            if(x1 <= x && x <= x2 && y1 <= y && y <= y2)
+            {
+                drawCell(*cell);
+            }
+        }
+    }
+
+    return true;
+}
+
+void CWptClusters::drawCluster(QPainter& p, const QPointF& pos, quint32 count, CBlockedAreas& blockedAreas)
+{
+    const QString& str = QString::number(count);
+    const QFontMetricsF fm(p.font());
+
+    // grow the marker with the number of digits
+    const qreal r = qMax(10.0, fm.width(str) / 2 + 5);
+    QRectF rect(0, 0, 2 * r, 2 * r);
+    rect.moveCenter(pos);
+
+    p.setPen(QPen(Qt::white, 2));
+    p.setBrush(QColor(0, 0, 180, 200));
+    p.drawEllipse(rect);
+    p.drawText(rect, Qt::AlignCenter, str);
+
+    blockedAreas << rect;
+}
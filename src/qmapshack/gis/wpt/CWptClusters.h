@@ -0,0 +1,115 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CWPTCLUSTERS_H
+#define CWPTCLUSTERS_H
+
+#include <QHash>
+#include <QPointF>
+#include <QSet>
+#include <QVector>
+
+class CBlockedAreas;
+class CGisDraw;
+class CGisItemWpt;
+class IGisItem;
+class IGisProject;
+class QPainter;
+class QPolygonF;
+
+/**
+   @brief Screen space clustering of projects with a large number of waypoints
+
+   Drawing tens of thousands of waypoint icons is slow and the result is
+   unreadable at low zoom levels. Therefore the waypoints of such a project
+   are sorted into a hierarchy of grids. Each level halves the cell size of
+   the previous one. For drawing the level with cells of about CELL_SIZE pixel
+   is selected. A cell with a single waypoint draws the waypoint. A cell with
+   more waypoints draws a marker with the number of waypoints instead. The
+   effort is limited by the number of cells visible on the screen.
+
+   The grid is calculated on first use after it has been invalidated.
+ */
+class CWptClusters
+{
+public:
+    CWptClusters() = default;
+    virtual ~CWptClusters() = default;
+
+    /// mark the grid as outdated. Must be called on any change of the project's items
+    void invalidate();
+
+    /**
+       @brief Draw the project's waypoints clustered
+
+       @param project       the project owning this object
+       @param p             the painter to draw on
+       @param viewport      the visible area in [rad]
+       @param blockedAreas  areas already occupied on the screen
+       @param gis           the draw context
+       @return False if there is no need to cluster at the current zoom level.
+     */
+    bool draw(IGisProject& project, QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CGisDraw * gis);
+
+    /// test if an item is handled by the clustering if draw() returned true
+    bool contains(const IGisItem * item) const
+    {
+        return members.contains(item);
+    }
+
+private:
+    void build(IGisProject& project);
+    void resetScreenPos(bool all);
+    void drawCluster(QPainter& p, const QPointF& pos, quint32 count, CBlockedAreas& blockedAreas);
+
+    static quint64 key(qint32 x, qint32 y)
+    {
+        return (quint64(quint32(x)) << 32) | quint32(y);
+    }
+
+    /// clustering starts with this number of waypoints in a project
+    static constexpr int MIN_WPTS = 500;
+    /// the finest level with a cell size of 360°/2^MAX_LEVEL
+    static constexpr int MAX_LEVEL = 16;
+    /// the minimum cell size on the screen in [px]
+    static constexpr qreal CELL_SIZE = 64;
+
+    struct cell_t
+    {
+        quint32 count = 0;
+        /// sum of all positions in [°] to calculate the cluster's center
+        QPointF sum;
+        /// the first waypoint in the cell, drawn if it is the only one
+        CGisItemWpt * wpt = nullptr;
+    };
+
+    bool valid = false;
+    /// true if the last call to draw() did clustering
+    bool active = false;
+
+    /// the waypoints handled by the clustering
+    QVector<CGisItemWpt*> wpts;
+    /// the same as wpts for fast lookup
+    QSet<const IGisItem*> members;
+    /// the cells of all levels
+    QVector<QHash<quint64, cell_t> > levels;
+    /// the waypoints drawn as single icon by the last call to draw()
+    QVector<CGisItemWpt*> singles;
+};
+
+#endif //CWPTCLUSTERS_H
@@ -0,0 +1,115 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "helpers/CBlockedAreas.h"
+
+#include <QtCore>
+
+/// areas covering more cells are tested linearly
+#define MAX_CELLS 64
+
+CBlockedAreas::CBlockedAreas(qreal cellSize)
+    : cellSize(cellSize)
+{
+}
+
+void CBlockedAreas::clear()
+{
+    rects.clear();
+    grid.clear();
+    large.clear();
+}
+
+bool CBlockedAreas::getCells(const QRectF& rect, QRect& cells) const
+{
+    const QRectF& r = rect.normalized();
+
+    cells.setLeft(qFloor(r.left() / cellSize));
+    cells.setTop(qFloor(r.top() / cellSize));
+    cells.setRight(qFloor(r.right() / cellSize));
+    cells.setBottom(qFloor(r.bottom() / cellSize));
+
+    return (qint64(cells.width()) * cells.height()) <= MAX_CELLS;
+}
+
+void CBlockedAreas::add(const QRectF& rect)
+{
+    const qint32 idx = rects.size();
+    rects << rect;
+
+    QRect cells;
+    if(!getCells(rect, cells))
+    {
+        large << idx;
+        return;
+    }
+
+    for(qint32 y = cells.top(); y <= cells.bottom(); y++)
+    {
+        for(qint32 x = cells.left(); x <= cells.right(); x++)
+        {
+            grid[key(x, y)] << idx;
+        }
+    }
+}
+
+bool CBlockedAreas::intersects(const QRectF& rect) const
+{
+    for(qint32 idx : large)
+    {
+        if(rects[idx].intersects(rect))
+        {
+            return true;
+        }
+    }
+
+    QRect cells;
+    if(!getCells(rect, cells))
+    {
+        for(const QRectF& r : rects)
+        {
+            if(r.intersects(rect))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for(qint32 y = cells.top(); y <= cells.bottom(); y++)
+    {
+        for(qint32 x = cells.left(); x <= cells.right(); x++)
+        {
+            const QHash<quint32, QVector<qint32> >::const_iterator cell = grid.constFind(key(x, y));
+            if(cell == grid.constEnd())
+            {
+                continue;
+            }
+
+            for(qint32 idx : *cell)
+            {
+                if(rects[idx].intersects(rect))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
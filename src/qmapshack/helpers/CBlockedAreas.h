@@ -0,0 +1,92 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CBLOCKEDAREAS_H
+#define CBLOCKEDAREAS_H
+
+#include <QHash>
+#include <QRectF>
+#include <QVector>
+
+/**
+   @brief A collection of screen areas already occupied by icons and labels
+
+   Labels are only drawn if they do not overlap with anything drawn before.
+   Testing a new label against all areas drawn so far is quadratic. Therefore
+   the areas are sorted into a uniform grid of cells. A test only has to look
+   at the areas registered in the cells covered by the tested rectangle.
+ */
+class CBlockedAreas
+{
+public:
+    CBlockedAreas(qreal cellSize = 64);
+    virtual ~CBlockedAreas() = default;
+
+    void clear();
+
+    bool isEmpty() const
+    {
+        return rects.isEmpty();
+    }
+
+    int count() const
+    {
+        return rects.count();
+    }
+
+    /// block the area of the given rectangle
+    void add(const QRectF& rect);
+
+    CBlockedAreas& operator<<(const QRectF& rect)
+    {
+        add(rect);
+        return *this;
+    }
+
+    /// test if the rectangle intersects with any of the blocked areas
+    bool intersects(const QRectF& rect) const;
+
+private:
+    /**
+       @brief Get the range of cells covered by a rectangle
+
+       @param rect      the rectangle in screen coordinates
+       @param cells     the range of cell indices
+       @return False if the rectangle covers too many cells to be sorted into the grid
+     */
+    bool getCells(const QRectF& rect, QRect& cells) const;
+
+    static quint32 key(qint32 x, qint32 y)
+    {
+        // cells far apart can share a key. That is ok as the
+        // final test is always done on the rectangle itself.
+        return (quint32(quint16(x)) << 16) | quint16(y);
+    }
+
+    qreal cellSize;
+
+    /// all blocked areas
+    QVector<QRectF> rects;
+    /// the indices into rects registered per cell
+    QHash<quint32, QVector<qint32> > grid;
+    /// indices of areas too large to be registered in the grid
+    QVector<qint32> large;
+};
+
+#endif //CBLOCKEDAREAS_H
+
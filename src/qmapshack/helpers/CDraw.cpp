@@ -18,6 +18,7 @@
 **********************************************************************************************/
 
 #include "canvas/CCanvas.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CDraw.h"
 
 #include <QDebug>
@@ -257,16 +258,9 @@ QPoint CDraw::bubble(QPainter &p, const QRect &contentRect, const QPoint &pointe
     return contentRect.topLeft();
 }
 
-bool CDraw::doesOverlap(const QList<QRectF>& blockedAreas, const QRectF& rect)
+bool CDraw::doesOverlap(const CBlockedAreas& blockedAreas, const QRectF& rect)
 {
-    for(const QRectF& r : blockedAreas)
-    {
-        if(r.intersects(rect))
-        {
-            return true;
-        }
-    }
-    return false;
+    return blockedAreas.intersects(rect);
 }
 
 
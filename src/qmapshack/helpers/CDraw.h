@@ -25,6 +25,9 @@
 #include <QRectF>
 
 #include "CMainWindow.h"
+
+class CBlockedAreas;
+
 inline void USE_ANTI_ALIASING(QPainter& p, bool useAntiAliasing)
 {
     p.setRenderHints(QPainter::TextAntialiasing | QPainter::Antialiasing | QPainter::SmoothPixmapTransform | QPainter::HighQualityAntialiasing, useAntiAliasing);
@@ -104,7 +107,7 @@ public:
     static QPoint bubble(QPainter &p, const QRect &contentRect, const QPoint &pointerPos, const QColor &background);
 
 
-    static bool doesOverlap(const QList<QRectF>& blockedAreas, const QRectF& rect);
+    static bool doesOverlap(const CBlockedAreas& blockedAreas, const QRectF& rect);
 
     /**
        @brief   Creates a new arrow using the brush specified
@@ -22,53 +22,83 @@
 #include <QFile>
 #include <QtCore>
 
+/**
+   @brief A QFile with cheap access to memory mapped sections
+
+   On the first access the complete file is mapped once and the mapping is
+   kept until the file is closed. All following calls to data() are simple
+   pointer arithmetic without any system call. If the file can't be mapped as
+   a whole (e.g. a huge gmapsupp.img in a 32bit address space) each section is
+   mapped on its own and has to be released by free().
+
+   The file can be shared by several threads, e.g. the GUI thread and a render
+   thread. Each separately mapped section belongs to the thread that mapped it.
+   free() releases the sections of the calling thread only. Thus a thread can't
+   unmap a section another thread is still reading.
+ */
 class CFileExt : public QFile
 {
 public:
     CFileExt(const QString &filename)
         : QFile(filename)
-        , mapped(nullptr)
     {
         cnt++;
     }
 
     ~CFileExt()
     {
+        close();
         cnt--;
     }
 
-#ifndef Q_OS_WIN32
+    void close() override
+    {
+        QMutexLocker lock(&mutex);
+        mappedAll = nullptr;
+        triedMapAll = false;
+        mappedSections.clear();
+        // QFile::close() will unmap all sections
+        QFile::close();
+    }
+
     // data access function
     const char *data(qint64 offset, qint64 s)
     {
-        mapped = map(offset, s);
-        mappedSections << mapped;
-        return (const char*)mapped;
+        QMutexLocker lock(&mutex);
+        if(!triedMapAll)
+        {
+            triedMapAll = true;
+            mappedAll   = map(0, size());
+        }
+
+        if(mappedAll != nullptr)
+        {
+            return (const char*)(mappedAll + offset);
+        }
+
+        uchar * p = map(offset, s);
+        mappedSections[QThread::currentThreadId()] << p;
+        return (const char*)p;
     }
 
+    /// release all sections mapped separately by the calling thread, the persistent mapping is kept
     void free()
     {
-        for(uchar * p : mappedSections)
+        QMutexLocker lock(&mutex);
+        for(uchar * p : mappedSections.take(QThread::currentThreadId()))
         {
             unmap(p);
         }
-        mappedSections.clear();
-    }
-
-#else
-    // data access function
-    const char *data(qint64 offset, qint64 s)
-    {
-        uchar * p = map(offset, s);
-        return (const char *)p;
     }
-#endif
 
 private:
     static int cnt;
 
-    uchar *mapped;
-    QSet<uchar*> mappedSections;
+    QMutex mutex;
+    bool triedMapAll = false;
+    uchar *mappedAll = nullptr;
+    /// the sections mapped separately, by the thread that uses them
+    QHash<Qt::HANDLE, QList<uchar*> > mappedSections;
 };
 
 
@@ -26,7 +26,11 @@ class CSettings : public QObject
 public:
     CSettings()
     {
-        if(!qlOpts->configfile.isEmpty())
+        if(!qlOpts->batchConfigfile.isEmpty())
+        {
+            cfg = new QSettings(qlOpts->batchConfigfile, QSettings::IniFormat, this);
+        }
+        else if(!qlOpts->configfile.isEmpty())
         {
             cfg = new QSettings(qlOpts->configfile, QSettings::IniFormat, this);
         }
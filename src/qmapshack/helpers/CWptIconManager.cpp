@@ -59,8 +59,20 @@ QPixmap CWptIconManager::createGrayscale(QString path)
     return pixmap_gray;
 }
 
+void CWptIconManager::removeFromCache(const QString& path)
+{
+    QMutexLocker lock(&mutex);
+    cacheIcons.remove(path);
+    cacheScaledIcons.remove(path);
+}
+
 void CWptIconManager::init()
 {
+    QMutexLocker lock(&mutex);
+    // the path of the external icons might have changed
+    cacheIcons.clear();
+    cacheScaledIcons.clear();
+
     wptIcons.clear();
 
     wptIcons["Default"]             = icon_t(wptDefault, 16, 16);
@@ -153,8 +165,10 @@ void CWptIconManager::init()
 
 void CWptIconManager::setWptIconByName(const QString& name, const QString& filename)
 {
-    QPixmap icon(filename);
-    wptIcons[name] = icon_t(filename, icon.width() >> 1, icon.height() >> 1);
+    // no need to decode the complete image just to get the size
+    const QSize& size = QImageReader(filename).size();
+    wptIcons[name] = icon_t(filename, size.width() >> 1, size.height() >> 1);
+    removeFromCache(filename);
 }
 
 
@@ -166,27 +180,39 @@ void CWptIconManager::setWptIconByName(const QString& name, const QPixmap& icon)
 
     icon.save(filename);
     wptIcons[name] = icon_t(filename, icon.width() >> 1, icon.height() >> 1);
+    removeFromCache(filename);
 }
 
 QPixmap CWptIconManager::loadIcon(const QString& path)
 {
+    QMutexLocker lock(&mutex);
+    if(cacheIcons.contains(path))
+    {
+        return cacheIcons[path];
+    }
+
+    QPixmap icon;
     QFileInfo finfo(path);
     if(finfo.completeSuffix() != "bmp")
     {
-        return QPixmap(path);
+        icon = QPixmap(path);
     }
     else
     {
         QImage img = QPixmap(path).toImage().convertToFormat(QImage::Format_Indexed8);
         img.setColor(0, qRgba(0, 0, 0, 0));
-        return QPixmap::fromImage(img);
+        icon = QPixmap::fromImage(img);
     }
+
+    cacheIcons[path] = icon;
+    return icon;
 }
 
 
 QPixmap CWptIconManager::getWptIconByName(const QString& name, QPointF &focus, QString * src)
 {
-    QPixmap icon;
+    QMutexLocker lock(&mutex);
+
     QString path;
 
     if(wptIcons.contains(name))
@@ -210,26 +236,30 @@ QPixmap CWptIconManager::getWptIconByName(const QString& name, QPointF &focus, Q
         *src = path;
     }
 
-    icon = loadIcon(path);
-
-    // Limit icon size to 22 pixel max.
-    if(icon.width() > 22 || icon.height() > 22)
+    if(!cacheScaledIcons.contains(path))
     {
-        qreal s;
-        if(icon.width() > icon.height())
-        {
-            s = 22.0 / icon.width();
-        }
-        else
+        scaled_icon_t& scaled = cacheScaledIcons[path];
+        scaled.icon = loadIcon(path);
+
+        // Limit icon size to 22 pixel max.
+        if(scaled.icon.width() > 22 || scaled.icon.height() > 22)
         {
-            s = 22.0 / icon.height();
+            if(scaled.icon.width() > scaled.icon.height())
+            {
+                scaled.scale = 22.0 / scaled.icon.width();
+            }
+            else
+            {
+                scaled.scale = 22.0 / scaled.icon.height();
+            }
+
+            scaled.icon = scaled.icon.scaled(scaled.icon.size() * scaled.scale, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         }
-
-        focus = focus * s;
-        icon  = icon.scaled(icon.size() * s, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
 
-    return icon;
+    const scaled_icon_t& scaled = cacheScaledIcons[path];
+    focus = focus * scaled.scale;
+    return scaled.icon;
 }
 
 QString CWptIconManager::selectWptIcon(QWidget * parent)
@@ -20,8 +20,11 @@
 #define CWPTICONMANAGER_H
 
 #include <QFont>
+#include <QHash>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
+#include <QPixmap>
 #include <QPoint>
 #include <QString>
 #include <QTemporaryFile>
@@ -61,6 +64,14 @@ public:
     QString getNumberedBullet(qint32 n);
 
 private:
+    /// an icon limited to the max. waypoint icon size
+    struct scaled_icon_t
+    {
+        QPixmap icon;
+        /// the scale factor applied to the original icon
+        qreal scale = 1.0;
+    };
+
     friend class CMainWindow;
     CWptIconManager(QObject * parent);
 
@@ -78,6 +89,21 @@ private:
     QMap<qint32, QString> mapNumberedBullets;
 
     QPixmap createGrayscale(QString path);
+
+    /// drop all cached icons of a file
+    void removeFromCache(const QString& path);
+
+    /**
+        Decoding icons is expensive. Loading a large number of waypoints
+        would decode the same few icons over and over again. Therefore
+        all icons are cached by their path. As QPixmap is implicitly shared
+        all waypoints with the same symbol share the same pixmap.
+     */
+    QMutex mutex {QMutex::Recursive};
+    /// icons as loaded by loadIcon()
+    QHash<QString, QPixmap> cacheIcons;
+    /// icons as returned by getWptIconByName()
+    QHash<QString, scaled_icon_t> cacheScaledIcons;
 };
 
 #endif //CWPTICONMANAGER_H
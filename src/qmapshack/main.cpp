@@ -16,8 +16,11 @@
 
 **********************************************************************************************/
 
+#include "canvas/CBenchmark.h"
 #include "CMainWindow.h"
 #include "CSingleInstanceProxy.h"
+#include "helpers/CSettings.h"
+#include "print/CBatchRender.h"
 #include "setup/IAppSetup.h"
 #include "version.h"
 
@@ -28,6 +31,16 @@
 
 int main(int argc, char ** argv)
 {
+    // rendering without GUI does not need a display
+    for(int i = 1; i < argc; i++)
+    {
+        const bool noGui = qstrcmp(argv[i], "--render") == 0 || qstrcmp(argv[i], "--bench") == 0;
+        if(noGui && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication app(argc, argv);
 
     QCoreApplication::setApplicationName("QMapShack");
@@ -47,6 +60,40 @@ int main(int argc, char ** argv)
     // setup default proxy
     QNetworkProxyFactory::setUseSystemConfiguration(true);
 
+    /*
+        The hidden main window of --render and --bench reads the user's setup
+        as usual. But all the widgets write their setup back on destruction.
+        Let them write to a copy that is removed afterwards.
+     */
+    QTemporaryFile batchConfig;
+    if(qlOpts->isBatch() && batchConfig.open())
+    {
+        SETTINGS;
+        QSettings copy(batchConfig.fileName(), QSettings::IniFormat);
+        for(const QString& key : cfg.allKeys())
+        {
+            copy.setValue(key, cfg.value(key));
+        }
+        copy.sync();
+        qlOpts->batchConfigfile = batchConfig.fileName();
+    }
+
+    if(!qlOpts->renderFile.isEmpty())
+    {
+        // the main window is needed but not shown
+        CMainWindow w;
+        CBatchRender render;
+        return render.exec();
+    }
+
+    if(!qlOpts->benchScenario.isEmpty())
+    {
+        // the main window is needed but not shown
+        CMainWindow w;
+        CBenchmark bench(qlOpts->benchScenario);
+        return bench.exec();
+    }
+
     // make sure this is the one and only instance on the system
     CSingleInstanceProxy s(qlOpts->arguments);
 
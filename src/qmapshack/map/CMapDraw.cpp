@@ -17,6 +17,7 @@
 **********************************************************************************************/
 
 #include "canvas/CCanvas.h"
+#include "canvas/CRenderStats.h"
 #include "CMainWindow.h"
 #include "gis/Poi.h"
 #include "helpers/CDraw.h"
@@ -333,6 +334,11 @@ void CMapDraw::buildMapList()
     mapList->updateHelpText();
 }
 
+void CMapDraw::updateMapListHelpText()
+{
+    mapList->updateHelpText();
+}
+
 void CMapDraw::saveActiveMapsList(QStringList& keys)
 {
     SETTINGS;
@@ -350,7 +356,8 @@ void CMapDraw::saveActiveMapsList(QStringList& keys, QSettings& cfg)
     for(int i = 0; i < mapList->count(); i++)
     {
         CMapItem * item = mapList->item(i);
-        if(item && !item->getMapfile().isNull())
+        // maps still loading in the background are active, too
+        if(item && (!item->getMapfile().isNull() || item->isLoading()))
         {
             item->saveConfig(cfg);
             keys << item->getKey();
@@ -387,9 +394,10 @@ void CMapDraw::restoreActiveMapsList(const QStringList& keys)
             {
                 /**
                     @Note   the item will load it's configuration upon successful activation
-                            by calling loadConfigForMapItem().
+                            by calling loadConfigForMapItem(). This works for maps loaded
+                            in the background, too.
                  */
-                item->activate();
+                item->activateAsync();
                 break;
             }
         }
@@ -431,6 +439,8 @@ void CMapDraw::reportStatusToCanvas(const QString& key, const QString& msg)
 void CMapDraw::drawt(IDrawContext::buffer_t& currentBuffer) /* override */
 {
     bool seenActiveMap = false;
+    bool seenMapNoReuse = false;
+    bool seenMapPreview = false;
     // iterate over all active maps and call the draw method
     CMapItem::mutexActiveMaps.lock();
     if(mapList && (mapList->count() != 0))
@@ -447,12 +457,31 @@ void CMapDraw::drawt(IDrawContext::buffer_t& currentBuffer) /* override */
                 break;
             }
 
-            item->getMapfile()->draw(currentBuffer);
+            if(CRenderStats::isEnabled())
+            {
+                QElapsedTimer t;
+                t.start();
+                item->getMapfile()->draw(currentBuffer);
+                CRenderStats::addTiming(canvas->objectName() + "/map/" + item->getName(), t.nsecsElapsed() / 1000000.0);
+            }
+            else
+            {
+                item->getMapfile()->draw(currentBuffer);
+            }
             seenActiveMap = true;
+
+            // vector maps place labels depending on the buffer's extent and
+            // online maps request all tiles of a buffer at once
+            const IMap * mapfile = item->getMapfile();
+            seenMapNoReuse |= mapfile->hasFeatureVectorItems() || mapfile->hasFeatureTileCache();
+            seenMapPreview |= mapfile->hasPreview();
         }
     }
     CMapItem::mutexActiveMaps.unlock();
 
+    reuseBuffer = !seenMapNoReuse;
+    previewMaps = seenMapPreview;
+
     if(seenActiveMap != hasActiveMap)
     {
         hasActiveMap = seenActiveMap;
@@ -132,11 +132,26 @@ public:
      */
     void buildMapList(const QString& filename);
 
+    /**
+       @brief Update the help text of the map list
+
+       Needed when a map finished loading in the background.
+     */
+    void updateMapListHelpText();
+
 signals:
     void sigActiveMapsChanged(bool noActiveMap);
 
 protected:
     void drawt(buffer_t& currentBuffer) override;
+    bool hasPreview() const override
+    {
+        return previewMaps;
+    }
+    bool canReuseBuffer() const override
+    {
+        return reuseBuffer;
+    }
 
 
 private:
@@ -195,6 +210,10 @@ private:
     static QStringList supportedFormats;
 
     bool hasActiveMap = false;
+    /// false if one of the active maps can't draw parts of the buffer without seams
+    bool reuseBuffer = false;
+    /// true if one of the active maps draws faster in a preview pass
+    bool previewMaps = false;
 };
 
 #endif //CMAPDRAW_H
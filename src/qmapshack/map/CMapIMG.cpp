@@ -24,6 +24,7 @@
 #include "helpers/CFileExt.h"
 #include "helpers/CProgressDialog.h"
 #include "helpers/Platform.h"
+#include "map/cache/CMapIndexCache.h"
 #include "map/CMapDraw.h"
 #include "map/CMapIMG.h"
 #include "map/garmin/CGarminStrTbl6.h"
@@ -43,6 +44,8 @@
 #undef DEBUG_SHOW_SUBDIV_BORDERS
 
 #define STREETNAME_THRESHOLD 5.0
+#define UNMASKED_CACHE_THRESHOLD 0x1000
+#define UNMASKED_CACHE_SIZE_KB 0x10000
 
 int CFileExt::cnt = 0;
 
@@ -114,29 +117,29 @@ static inline QImage img2line(const QImage &img, int width)
     return newImage;
 }
 
-static inline bool isCluttered(QVector<QRectF>& rectPois, const QRectF& rect)
+static inline bool isCluttered(CBlockedAreas& rectPois, const QRectF& rect)
 {
-    for(const QRectF &rectPoi : rectPois)
+    if(rectPois.intersects(rect))
     {
-        if(rect.intersects(rectPoi))
-        {
-            return true;
-        }
+        return true;
     }
     rectPois << rect;
     return false;
 }
 
 
-CMapIMG::CMapIMG(const QString &filename, CMapDraw *parent)
+CMapIMG::CMapIMG(const QString &filename, const QFont& mapFont, CMapDraw *parent)
     : IMap(eFeatVisibility | eFeatVectorItems | eFeatTypFile, parent)
     , filename(filename)
-    , fm(CMainWindow::self().getMapFont())
+    , imgFile(filename)
+    , fm(mapFont)
     , selectedLanguage(NOIDX)
 {
     qDebug() << "------------------------------";
     qDebug() << "IMG: try to open" << filename;
 
+    cacheUnmasked.setMaxCost(UNMASKED_CACHE_SIZE_KB);
+
     try
     {
         readBasics();
@@ -145,7 +148,7 @@ CMapIMG::CMapIMG(const QString &filename, CMapDraw *parent)
     }
     catch(const exce_t& e)
     {
-        QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed ..."), e.msg, QMessageBox::Abort);
+        reportLoadError(tr("Failed ..."), e.msg);
         return;
     }
 
@@ -431,7 +434,7 @@ void CMapIMG::setupTyp()
         QFile file(typeFile);
         if(!file.open(QIODevice::ReadOnly))
         {
-            QMessageBox::warning(CMainWindow::self().getBestWidgetForParent(), tr("Read external type file..."), tr("Failed to read type file: %1\nFall back to internal types.").arg(typeFile), QMessageBox::Ok);
+            reportLoadError(tr("Read external type file..."), tr("Failed to read type file: %1\nFall back to internal types.").arg(typeFile));
             typeFile.clear();
             setupTyp();
             return;
@@ -440,6 +443,10 @@ void CMapIMG::setupTyp()
         QByteArray array = file.readAll();
         CGarminTyp typ;
         typ.decode(array, polygonProperties, polylineProperties, polygonDrawOrder, pointProperties);
+        for(const QString& msg : typ.getWarnings())
+        {
+            reportLoadError(tr("Warning..."), msg);
+        }
 
         file.close();
     }
@@ -454,16 +461,18 @@ void CMapIMG::setupTyp()
                 continue;
             }
 
-            CFileExt file(filename);
-            file.open(QIODevice::ReadOnly);
-
             QByteArray array;
-            readFile(file, (*subfile).parts["TYP"].offset, (*subfile).parts["TYP"].size, array);
+            readFile(imgFile, (*subfile).parts["TYP"].offset, (*subfile).parts["TYP"].size, array);
 
             CGarminTyp typ;
             typ.decode(array, polygonProperties, polylineProperties, polygonDrawOrder, pointProperties);
+            for(const QString& msg : typ.getWarnings())
+            {
+                reportLoadError(tr("Warning..."), msg);
+            }
 
-            file.close();
+            // only needed if the file could not be mapped as a whole
+            imgFile.free();
             break;
         }
     }
@@ -476,13 +485,30 @@ void CMapIMG::readFile(CFileExt& file, quint32 offset, quint32 size, QByteArray&
         throw exce_t(eErrOpen, tr("Failed to read: ") + filename);
     }
 
-    data = QByteArray::fromRawData(file.data(offset, size), size);
     // wenn mask == 0 ist kein xor noetig
     if(mask == 0)
     {
+        // the data points directly into the persistent mapping of the file
+        data = QByteArray::fromRawData(file.data(offset, size), size);
         return;
     }
 
+    // large blocks (RGN) are read over and over again while drawing. Keep
+    // them unmasked to do the XOR only once.
+    const bool useCache = size >= UNMASKED_CACHE_THRESHOLD;
+    if(useCache)
+    {
+        QMutexLocker lock(&mutexCacheUnmasked);
+        const QByteArray * cached = cacheUnmasked.object(offset);
+        if(cached != nullptr && quint32(cached->size()) == size)
+        {
+            data = *cached;
+            return;
+        }
+    }
+
+    data = QByteArray(file.data(offset, size), size);
+
 #ifdef HOST_IS_64_BIT
     quint64 * p64 = (quint64*)data.data();
     for(quint32 i = 0; i < size / 8; ++i)
@@ -505,6 +531,12 @@ void CMapIMG::readFile(CFileExt& file, quint32 offset, quint32 size, QByteArray&
     {
         *p++ ^= mask;
     }
+
+    if(useCache)
+    {
+        QMutexLocker lock(&mutexCacheUnmasked);
+        cacheUnmasked.insert(offset, new QByteArray(data), qMax(size >> 10, quint32(1)));
+    }
 }
 
 
@@ -513,7 +545,7 @@ void CMapIMG::readBasics()
     char tmpstr[64];
     qint64 fsize    = QFileInfo(filename).size();
 
-    CFileExt file(filename);
+    CFileExt& file = imgFile;
     if(!file.open(QIODevice::ReadOnly))
     {
         throw exce_t(eErrOpen, tr("Failed to open: ") + filename);
@@ -533,6 +565,12 @@ void CMapIMG::readBasics()
     mask64 <<= 32;
     mask64  |= mask32;
 
+    if(restoreIndex())
+    {
+        setupCopyright();
+        return;
+    }
+
     // read hdr_img_t
     QByteArray imghdr;
     readFile(file, 0, sizeof(hdr_img_t), imghdr);
@@ -668,13 +706,25 @@ void CMapIMG::readBasics()
     int cnt = 1;
     int tot = subfiles.count();
 
-    PROGRESS_SETUP(tr("Loading %1").arg(QFileInfo(filename).fileName()), 0, tot, CMainWindow::getBestWidgetForParent());
+    // there is no progress dialog if the map is loaded by a worker thread
+    QScopedPointer<CProgressDialog> progress;
+    if(QThread::currentThread() == qApp->thread())
+    {
+        progress.reset(new CProgressDialog(tr("Loading %1").arg(QFileInfo(filename).fileName()), 0, tot, CMainWindow::getBestWidgetForParent()));
+    }
 
     maparea = QRectF();
     QMap<QString, subfile_desc_t>::iterator subfile = subfiles.begin();
     while(subfile != subfiles.end())
     {
-        PROGRESS(cnt++, throw exce_t(errAbort, tr("User abort: ") + filename));
+        if(!progress.isNull())
+        {
+            progress->setValue(cnt++);
+            if(progress->wasCanceled())
+            {
+                throw exce_t(errAbort, tr("User abort: ") + filename);
+            }
+        }
         if((*subfile).parts.contains("GMP"))
         {
             throw exce_t(errFormat, tr("File is NT format. QMapShack is unable to read map files with NT format: ") + filename);
@@ -684,7 +734,16 @@ void CMapIMG::readBasics()
 
         ++subfile;
     }
+    file.free();
+
+    setupCopyright();
+    storeIndex();
+
+    qDebug() << "dimensions:\t" << "N" << (maparea.bottom() * RAD_TO_DEG) << "E" << (maparea.right() * RAD_TO_DEG) << "S" << (maparea.top() * RAD_TO_DEG) << "W" << (maparea.left() * RAD_TO_DEG);
+}
 
+void CMapIMG::setupCopyright()
+{
     // combine copyright sections
     copyright.clear();
     for(const QString &str : copyrights)
@@ -695,8 +754,177 @@ void CMapIMG::readBasics()
         }
         copyright += str;
     }
+}
+
+/// increase this if any of the stored structures changes
+#define IMG_INDEX_VERSION 1
+
+static QDataStream& operator<<(QDataStream& stream, const CMapIMG::subdiv_desc_t& subdiv)
+{
+    stream << subdiv.n << subdiv.next << subdiv.terminate << subdiv.rgn_start << subdiv.rgn_end;
+    stream << subdiv.hasPoints << subdiv.hasIdxPoints << subdiv.hasPolylines << subdiv.hasPolygons;
+    stream << subdiv.iCenterLng << subdiv.iCenterLat;
+    stream << subdiv.north << subdiv.east << subdiv.south << subdiv.west << subdiv.area;
+    stream << subdiv.shift << subdiv.level;
+    stream << subdiv.offsetPoints2 << subdiv.lengthPoints2;
+    stream << subdiv.offsetPolylines2 << subdiv.lengthPolylines2;
+    stream << subdiv.offsetPolygons2 << subdiv.lengthPolygons2;
+    return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, CMapIMG::subdiv_desc_t& subdiv)
+{
+    stream >> subdiv.n >> subdiv.next >> subdiv.terminate >> subdiv.rgn_start >> subdiv.rgn_end;
+    stream >> subdiv.hasPoints >> subdiv.hasIdxPoints >> subdiv.hasPolylines >> subdiv.hasPolygons;
+    stream >> subdiv.iCenterLng >> subdiv.iCenterLat;
+    stream >> subdiv.north >> subdiv.east >> subdiv.south >> subdiv.west >> subdiv.area;
+    stream >> subdiv.shift >> subdiv.level;
+    stream >> subdiv.offsetPoints2 >> subdiv.lengthPoints2;
+    stream >> subdiv.offsetPolylines2 >> subdiv.lengthPolylines2;
+    stream >> subdiv.offsetPolygons2 >> subdiv.lengthPolygons2;
+    return stream;
+}
+
+static QDataStream& operator<<(QDataStream& stream, const CMapIMG::strtbl_desc_t& desc)
+{
+    stream << desc.isValid << desc.coding << desc.codepage;
+    stream << desc.offsetLbl1 << desc.sizeLbl1 << desc.shiftLbl1;
+    stream << desc.offsetLbl6 << desc.sizeLbl6;
+    stream << desc.hasNet << desc.offsetNet1 << desc.sizeNet1 << desc.shiftNet1;
+    return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, CMapIMG::strtbl_desc_t& desc)
+{
+    stream >> desc.isValid >> desc.coding >> desc.codepage;
+    stream >> desc.offsetLbl1 >> desc.sizeLbl1 >> desc.shiftLbl1;
+    stream >> desc.offsetLbl6 >> desc.sizeLbl6;
+    stream >> desc.hasNet >> desc.offsetNet1 >> desc.sizeNet1 >> desc.shiftNet1;
+    return stream;
+}
+
+void CMapIMG::storeIndex()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+
+    stream << mapdesc << transparent << maparea << copyrights;
+
+    stream << quint32(subfiles.count());
+    for(const subfile_desc_t& subfile : subfiles)
+    {
+        stream << subfile.name;
+
+        stream << quint32(subfile.parts.count());
+        for(const QString& key : subfile.parts.keys())
+        {
+            const subfile_part_t& part = subfile.parts[key];
+            stream << key << part.offset << part.size;
+        }
+
+        stream << subfile.north << subfile.east << subfile.south << subfile.west << subfile.area;
+        stream << subfile.isTransparent << subfile.strtblDesc;
+
+        stream << quint32(subfile.maplevels.count());
+        for(const maplevel_t& maplevel : subfile.maplevels)
+        {
+            stream << maplevel.inherited << maplevel.level << maplevel.bits;
+        }
+
+        stream << quint32(subfile.subdivs.count());
+        for(const subdiv_desc_t& subdiv : subfile.subdivs)
+        {
+            stream << subdiv;
+        }
+    }
 
-    qDebug() << "dimensions:\t" << "N" << (maparea.bottom() * RAD_TO_DEG) << "E" << (maparea.right() * RAD_TO_DEG) << "S" << (maparea.top() * RAD_TO_DEG) << "W" << (maparea.left() * RAD_TO_DEG);
+    CMapIndexCache::store(filename, "IMG", IMG_INDEX_VERSION, data);
+}
+
+bool CMapIMG::restoreIndex()
+{
+    QByteArray data;
+    if(!CMapIndexCache::restore(filename, "IMG", IMG_INDEX_VERSION, data))
+    {
+        return false;
+    }
+
+    QDataStream stream(&data, QIODevice::ReadOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+
+    QMap<QString, subfile_desc_t> tmpSubfiles;
+    QString tmpMapdesc;
+    bool tmpTransparent = false;
+    QRectF tmpMaparea;
+    QSet<QString> tmpCopyrights;
+
+    stream >> tmpMapdesc >> tmpTransparent >> tmpMaparea >> tmpCopyrights;
+
+    quint32 nSubfiles = 0;
+    stream >> nSubfiles;
+    for(quint32 i = 0; i < nSubfiles && stream.status() == QDataStream::Ok; i++)
+    {
+        QString name;
+        stream >> name;
+
+        subfile_desc_t& subfile = tmpSubfiles[name];
+        subfile.name = name;
+
+        quint32 nParts = 0;
+        stream >> nParts;
+        for(quint32 n = 0; n < nParts && stream.status() == QDataStream::Ok; n++)
+        {
+            QString key;
+            stream >> key;
+            subfile_part_t& part = subfile.parts[key];
+            stream >> part.offset >> part.size;
+        }
+
+        stream >> subfile.north >> subfile.east >> subfile.south >> subfile.west >> subfile.area;
+        stream >> subfile.isTransparent >> subfile.strtblDesc;
+
+        quint32 nMaplevels = 0;
+        stream >> nMaplevels;
+        for(quint32 n = 0; n < nMaplevels && stream.status() == QDataStream::Ok; n++)
+        {
+            maplevel_t maplevel;
+            stream >> maplevel.inherited >> maplevel.level >> maplevel.bits;
+            subfile.maplevels << maplevel;
+        }
+
+        quint32 nSubdivs = 0;
+        stream >> nSubdivs;
+        if(stream.status() != QDataStream::Ok || nSubdivs > quint32(data.size()))
+        {
+            return false;
+        }
+        subfile.subdivs.resize(nSubdivs);
+        for(subdiv_desc_t& subdiv : subfile.subdivs)
+        {
+            stream >> subdiv;
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        qDebug() << "IMG: index of" << filename << "is corrupt";
+        return false;
+    }
+
+    mapdesc     = tmpMapdesc;
+    transparent = tmpTransparent;
+    maparea     = tmpMaparea;
+    copyrights  = tmpCopyrights;
+    subfiles    = tmpSubfiles;
+
+    for(subfile_desc_t& subfile : subfiles)
+    {
+        setupStrTbl(subfile);
+    }
+
+    qDebug() << "IMG: restored index of" << filename;
+    return true;
 }
 
 void CMapIMG::readSubfileBasics(subfile_desc_t& subfile, CFileExt &file)
@@ -1056,32 +1284,60 @@ void CMapIMG::readSubfileBasics(subfile_desc_t& subfile, CFileExt &file)
 
         //         qDebug() << file.fileName() << hex << offsetLbl1 << offsetLbl6 << offsetNet1;
 
-        switch(pLblHdr->coding)
+        strtbl_desc_t& desc = subfile.strtblDesc;
+        desc.isValid    = true;
+        desc.coding     = pLblHdr->coding;
+        desc.codepage   = codepage;
+        desc.offsetLbl1 = offsetLbl1;
+        desc.sizeLbl1   = gar_load(quint32, pLblHdr->lbl1_length);
+        desc.shiftLbl1  = pLblHdr->addr_shift;
+        desc.offsetLbl6 = offsetLbl6;
+        desc.sizeLbl6   = gar_load(quint32, pLblHdr->lbl6_length);
+        if(nullptr != pNetHdr)
         {
-        case 0x06:
-            subfile.strtbl = new CGarminStrTbl6(codepage, mask, this);
-            break;
+            desc.hasNet     = true;
+            desc.offsetNet1 = offsetNet1;
+            desc.sizeNet1   = gar_load(quint32, pNetHdr->net1_length);
+            desc.shiftNet1  = pNetHdr->net1_addr_shift;
+        }
 
-        case 0x09:
-            subfile.strtbl = new CGarminStrTbl8(codepage, mask, this);
-            break;
+        setupStrTbl(subfile);
+    }
+}
 
-        case 0x0A:
-            subfile.strtbl = new CGarminStrTblUtf8(codepage, mask, this);
-            break;
+void CMapIMG::setupStrTbl(subfile_desc_t& subfile)
+{
+    const strtbl_desc_t& desc = subfile.strtblDesc;
+    if(!desc.isValid)
+    {
+        return;
+    }
 
-        default:
-            qWarning() << "Unknown label coding" << hex << pLblHdr->coding;
-        }
+    switch(desc.coding)
+    {
+    case 0x06:
+        subfile.strtbl = new CGarminStrTbl6(desc.codepage, mask, this);
+        break;
+
+    case 0x09:
+        subfile.strtbl = new CGarminStrTbl8(desc.codepage, mask, this);
+        break;
 
-        if(nullptr != subfile.strtbl)
+    case 0x0A:
+        subfile.strtbl = new CGarminStrTblUtf8(desc.codepage, mask, this);
+        break;
+
+    default:
+        qWarning() << "Unknown label coding" << hex << desc.coding;
+    }
+
+    if(nullptr != subfile.strtbl)
+    {
+        subfile.strtbl->registerLBL1(desc.offsetLbl1, desc.sizeLbl1, desc.shiftLbl1);
+        subfile.strtbl->registerLBL6(desc.offsetLbl6, desc.sizeLbl6);
+        if(desc.hasNet)
         {
-            subfile.strtbl->registerLBL1(offsetLbl1, gar_load(quint32, pLblHdr->lbl1_length), pLblHdr->addr_shift);
-            subfile.strtbl->registerLBL6(offsetLbl6, gar_load(quint32, pLblHdr->lbl6_length));
-            if(nullptr != pNetHdr)
-            {
-                subfile.strtbl->registerNET1(offsetNet1, gar_load(quint32, pNetHdr->net1_length), pNetHdr->net1_addr_shift);
-            }
+            subfile.strtbl->registerNET1(desc.offsetNet1, desc.sizeNet1, desc.shiftNet1);
         }
     }
 }
@@ -1263,13 +1519,14 @@ void CMapIMG::draw(IDrawContext::buffer_t& buf) /* override */
     qreal v2 = qMin(buf.ref4.y(), buf.ref3.y());
 
     QRectF viewport(u1, v1, u2 - u1, v2 - v1);
-    QVector<QRectF> rectPois;
+    CBlockedAreas rectPois;
 
     polygons.clear();
     polylines.clear();
     pois.clear();
     points.clear();
     labels.clear();
+    labelAreas.clear();
 
     /**
        convertRad2Px() converts positions into screen coordinates. However the painter
@@ -1290,7 +1547,8 @@ void CMapIMG::draw(IDrawContext::buffer_t& buf) /* override */
 
     try
     {
-        loadVisibleData(false, polygons, polylines, points, pois, maplevel->level, viewport, p);
+        // the preview loads polygons without labels only
+        loadVisibleData(buf.preview, polygons, polylines, points, pois, maplevel->level, viewport, p);
     }
     catch(std::bad_alloc)
     {
@@ -1306,7 +1564,7 @@ void CMapIMG::draw(IDrawContext::buffer_t& buf) /* override */
     }
     drawPolygons(p, polygons);
 
-    if(map->needsRedraw())
+    if(map->needsRedraw() || buf.preview)
     {
         p.restore();
         return;
@@ -1346,13 +1604,11 @@ void CMapIMG::draw(IDrawContext::buffer_t& buf) /* override */
 
 void CMapIMG::loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polylines, pointtype_t& points, pointtype_t& pois, unsigned level, const QRectF& viewport, QPainter& p)
 {
-#ifndef Q_OS_WIN32
-    CFileExt file(filename);
-    if(!file.open(QIODevice::ReadOnly))
+    CFileExt& file = imgFile;
+    if(!file.isOpen())
     {
         return;
     }
-#endif
 
     for(const subfile_desc_t &subfile : subfiles)
     {
@@ -1371,14 +1627,6 @@ void CMapIMG::loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polyl
             break;
         }
 
-#ifdef Q_OS_WIN32
-        CFileExt file(filename);
-        if(!file.open(QIODevice::ReadOnly))
-        {
-            return;
-        }
-#endif
-
         QByteArray rgndata;
         readFile(file, subfile.parts["RGN"].offset, subfile.parts["RGN"].size, rgndata);
 
@@ -1432,16 +1680,9 @@ void CMapIMG::loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polyl
         p.drawPolygon(poly);
 #endif // DEBUG_SHOW_SUBDIV_BORDERS
 
-#ifdef Q_OS_WIN32
-        file.close();
-#else
+        // only needed if the file could not be mapped as a whole
         file.free();
-#endif
     }
-
-#ifndef Q_OS_WIN32
-    file.close();
-#endif
 }
 
 void CMapIMG::loadSubDiv(CFileExt &file, const subdiv_desc_t& subdiv, IGarminStrTbl * strtbl, const QByteArray& rgndata, bool fast, const QRectF& viewport, polytype_t& polylines, polytype_t& polygons, pointtype_t& points, pointtype_t& pois)
@@ -2010,15 +2251,7 @@ void CMapIMG::collectText(const CGarminPolygon& item, const QPolygonF& line, con
 
 bool CMapIMG::intersectsWithExistingLabel(const QRect &rect) const
 {
-    for(const strlbl_t &label : labels)
-    {
-        if(label.rect.intersects(rect))
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return labelAreas.intersects(rect);
 }
 
 void CMapIMG::addLabel(const CGarminPoint &pt, const QRect &rect, CGarminTyp::label_type_e type)
@@ -2035,9 +2268,11 @@ void CMapIMG::addLabel(const CGarminPoint &pt, const QRect &rect, CGarminTyp::la
     strlbl.str  = str;
     strlbl.rect = rect;
     strlbl.type = type;
+
+    labelAreas << rect;
 }
 
-void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPois)
+void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, CBlockedAreas& rectPois)
 {
     pointtype_t::iterator pt = pts.begin();
     while(pt != pts.end())
@@ -2097,7 +2332,7 @@ void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPoi
 }
 
 
-void CMapIMG::drawPois(QPainter& p, pointtype_t& pts, QVector<QRectF> &rectPois)
+void CMapIMG::drawPois(QPainter& p, pointtype_t& pts, CBlockedAreas &rectPois)
 {
     CGarminTyp::label_type_e labelType = CGarminTyp::eStandard;
 
@@ -19,16 +19,18 @@
 #ifndef CMAPIMG_H
 #define CMAPIMG_H
 
+#include "helpers/CBlockedAreas.h"
+#include "helpers/CFileExt.h"
 #include "map/garmin/CGarminPoint.h"
 #include "map/garmin/CGarminPolygon.h"
 #include "map/garmin/CGarminTyp.h"
 #include "map/garmin/Garmin.h"
 #include "map/IMap.h"
 
+#include <QCache>
 #include <QMap>
 
 class CMapDraw;
-class CFileExt;
 class IGarminStrTbl;
 
 typedef QVector<CGarminPolygon> polytype_t;
@@ -93,6 +95,25 @@ public:
         qint32 lengthPolygons2;
     };
 
+    /// string table setup as read from the LBL and NET headers
+    struct strtbl_desc_t
+    {
+        bool isValid     = false; //< true if the subfile has a LBL part
+        quint8 coding    = 0;
+        quint16 codepage = 0;
+
+        quint32 offsetLbl1 = 0;
+        quint32 sizeLbl1   = 0;
+        quint8 shiftLbl1   = 0;
+        quint32 offsetLbl6 = 0;
+        quint32 sizeLbl6   = 0;
+
+        bool hasNet        = false; //< true if the subfile has a NET part
+        quint32 offsetNet1 = 0;
+        quint32 sizeNet1   = 0;
+        quint8 shiftNet1   = 0;
+    };
+
     struct subfile_desc_t
     {
         /// the name of the subfile (not really needed)
@@ -114,17 +135,32 @@ public:
         QVector<maplevel_t> maplevels;
         /// bit 1 of POI_flags (TRE header @ 0x3F)
         bool isTransparent = false;
+        /// the parameters needed to create the string table object
+        strtbl_desc_t strtblDesc;
         /// object to manage the string tables
         IGarminStrTbl * strtbl = nullptr;
     };
 
-    CMapIMG(const QString &filename, CMapDraw *parent);
+    /**
+       @brief Load a map file
+
+       @param filename  the map file
+       @param mapFont   the font used for labels, read by the GUI thread as the map might be loaded by a worker thread
+       @param parent    the draw context the map is attached to
+     */
+    CMapIMG(const QString &filename, const QFont& mapFont, CMapDraw *parent);
     virtual ~CMapIMG() = default;
 
     void loadConfig(QSettings& cfg) override;
 
     void draw(IDrawContext::buffer_t& buf) override;
 
+    bool hasPreview() const override
+    {
+        // the preview draws polygons only
+        return true;
+    }
+
     void getToolTip(const QPoint& px, QString& infotext) const override;
 
     void findPOICloseBy(const QPoint&, poi_t& poi) const override;
@@ -169,6 +205,12 @@ private:
     void setupTyp();
     void readBasics();
     void readSubfileBasics(subfile_desc_t& subfile, CFileExt &file);
+    void setupStrTbl(subfile_desc_t& subfile);
+    void setupCopyright();
+    /// restore all data of readBasics() from the map index cache
+    bool restoreIndex();
+    /// save all data of readBasics() to the map index cache
+    void storeIndex();
     void processPrimaryMapData();
     void readFile(CFileExt& file, quint32 offset, quint32 size, QByteArray& data);
     void loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polylines, pointtype_t& points, pointtype_t& pois, unsigned level, const QRectF& viewport, QPainter& p);
@@ -177,8 +219,8 @@ private:
     void addLabel(const CGarminPoint &pt, const QRect &rect, CGarminTyp::label_type_e type);
     void drawPolygons(QPainter& p, polytype_t& lines);
     void drawPolylines(QPainter& p, polytype_t& lines, const QPointF &scale);
-    void drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF> &rectPois);
-    void drawPois(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPois);
+    void drawPoints(QPainter& p, pointtype_t& pts, CBlockedAreas &rectPois);
+    void drawPois(QPainter& p, pointtype_t& pts, CBlockedAreas& rectPois);
     void drawLabels(QPainter& p, const QVector<strlbl_t> &lbls);
     void drawText(QPainter& p);
 
@@ -467,9 +509,14 @@ private:
     };
 
     QString filename;
+    /// the map file is kept open and mapped as long as the map is active
+    CFileExt imgFile;
     quint8 mask;
     quint32 mask32;
     quint64 mask64;
+    /// RGN blocks of a masked file already XORed with the mask, accessed by offset
+    QCache<quint32, QByteArray> cacheUnmasked;
+    QMutex mutexCacheUnmasked;
     QString mapdesc;
     /// hold all subfile descriptors
     /**
@@ -500,6 +547,8 @@ private:
     pointtype_t pois;
 
     QVector<strlbl_t> labels;
+    /// the areas of all labels for fast collision tests
+    CBlockedAreas labelAreas;
 
     struct textpath_t
     {
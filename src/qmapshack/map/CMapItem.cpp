@@ -16,6 +16,8 @@
 
 **********************************************************************************************/
 
+#include "CMainWindow.h"
+#include "canvas/CDrawObjectLoader.h"
 #include "map/CMapDraw.h"
 #include "map/CMapGEMF.h"
 #include "map/CMapIMG.h"
@@ -30,6 +32,7 @@
 #include <QtGui>
 
 QMutex CMapItem::mutexActiveMaps(QMutex::Recursive);
+quint32 CMapItem::activationCnt = 0;
 
 CMapItem::CMapItem(QTreeWidget *parent, CMapDraw * map)
     : QTreeWidgetItem(parent)
@@ -41,6 +44,8 @@ CMapItem::CMapItem(QTreeWidget *parent, CMapDraw * map)
 
 CMapItem::~CMapItem()
 {
+    // a running loader will delete the map object by itself
+    QObject::disconnect(connLoader);
 }
 
 void CMapItem::setFilename(const QString& name)
@@ -131,9 +136,15 @@ bool CMapItem::isActivated()
 bool CMapItem::toggleActivate()
 {
     QMutexLocker lock(&mutexActiveMaps);
-    if(mapfile.isNull())
+    if(loading)
     {
-        return activate();
+        cancelLoading();
+        return false;
+    }
+    else if(mapfile.isNull())
+    {
+        activateAsync();
+        return true;
     }
     else
     {
@@ -163,52 +174,136 @@ void CMapItem::deactivate()
     map->reportStatusToCanvas(text(0), "");
 }
 
-
-bool CMapItem::activate()
+IMap * CMapItem::createMap(const QString& filename, const QFont& mapFont, CMapDraw * map)
 {
-    QMutexLocker lock(&mutexActiveMaps);
-
-    delete mapfile;
-
     // load map by suffix
-    QFileInfo fi(filename);
-    if(fi.suffix().toLower() == "rmap")
+    const QString& suffix = QFileInfo(filename).suffix().toLower();
+    if(suffix == "rmap")
     {
-        mapfile = new CMapRMAP(filename, map);
+        return new CMapRMAP(filename, map);
     }
-    else if(fi.suffix().toLower() == "jnx")
+    else if(suffix == "jnx")
     {
-        mapfile = new CMapJNX(filename, map);
+        return new CMapJNX(filename, map);
     }
-    else if(fi.suffix().toLower() == "img")
+    else if(suffix == "img")
     {
-        mapfile = new CMapIMG(filename, map);
+        return new CMapIMG(filename, mapFont, map);
     }
-    else if(fi.suffix().toLower() == "vrt")
+    else if(suffix == "vrt")
     {
-        mapfile = new CMapVRT(filename, map);
+        return new CMapVRT(filename, map);
     }
-    else if(fi.suffix().toLower() == "map")
+    else if(suffix == "map")
     {
-        mapfile = new CMapMAP(filename, map);
+        return new CMapMAP(filename, map);
     }
-    else if(fi.suffix().toLower() == "wmts")
+    else if(suffix == "wmts")
     {
-        mapfile = new CMapWMTS(filename, map);
+        return new CMapWMTS(filename, map);
     }
-    else if(fi.suffix().toLower() == "tms")
+    else if(suffix == "tms")
+    {
+        return new CMapTMS(filename, map);
+    }
+    else if(suffix == "gemf")
+    {
+        return new CMapGEMF(filename, map);
+    }
+
+    return nullptr;
+}
+
+bool CMapItem::activate()
+{
+    QMutexLocker lock(&mutexActiveMaps);
+
+    cancelLoading();
+    delete mapfile;
+
+    activationIdx = ++activationCnt;
+    mapfile = createMap(filename, CMainWindow::self().getMapFont(), map);
+
+    return setupActivated();
+}
+
+void CMapItem::activateAsync()
+{
+    /*
+        Online maps create their network access manager in the constructor. It has
+        to live in the GUI thread. Therefore only file based formats are loaded by
+        a worker thread.
+     */
+    static const QSet<QString> asyncFormats {"img", "vrt", "jnx", "rmap", "map", "gemf"};
+
+    QMutexLocker lock(&mutexActiveMaps);
+    if(loading || !mapfile.isNull())
+    {
+        return;
+    }
+
+    if(!asyncFormats.contains(QFileInfo(filename).suffix().toLower()))
+    {
+        activate();
+        return;
+    }
+
+    activationIdx = ++activationCnt;
+
+    const QString fn = filename;
+    const QFont font = CMainWindow::self().getMapFont();
+    CMapDraw * m     = map;
+    CDrawObjectLoader * loader = new CDrawObjectLoader([fn, font, m]{ return createMap(fn, font, m); });
+    connLoader = QObject::connect(loader, &CDrawObjectLoader::finished, map, [this, loader]{ finishLoading(loader); });
+
+    loading = true;
+    setIcon(/* col */ 0, QIcon("://icons/32x32/Time.png"));
+    setToolTip(0, tr("Loading..."));
+
+    loader->load();
+}
+
+void CMapItem::cancelLoading()
+{
+    if(!loading)
     {
-        mapfile = new CMapTMS(filename, map);
+        return;
     }
-    else if(fi.suffix().toLower() == "gemf")
+
+    QObject::disconnect(connLoader);
+    loading = false;
+
+    updateIcon();
+    setToolTip(0, "");
+}
+
+void CMapItem::finishLoading(CDrawObjectLoader * loader)
+{
+    QObject::disconnect(connLoader);
+
+    IMap * obj = dynamic_cast<IMap*>(loader->takeObject());
+
+    QMutexLocker lock(&mutexActiveMaps);
+    loading = false;
+
+    mapfile = obj;
+    if(!mapfile.isNull())
     {
-        mapfile = new CMapGEMF(filename, map);
+        mapfile->setParent(map);
+        mapfile->showLoadErrors();
     }
 
+    setupActivated();
+    map->updateMapListHelpText();
+}
+
+bool CMapItem::setupActivated()
+{
     updateIcon();
     // no mapfiles loaded? Bad.
     if(mapfile.isNull())
     {
+        setToolTip(0, "");
         return false;
     }
 
@@ -217,13 +312,14 @@ bool CMapItem::activate()
     if(!mapfile->activated())
     {
         delete mapfile;
+        setToolTip(0, "");
         return false;
     }
 
     setToolTip(0, mapfile->getCopyright());
 
     // append list of active map files
-    moveToBottom();
+    moveToActivationPosition();
 
     // an active map is subject to drag-n-drop
     setFlags(flags() | Qt::ItemIsDragEnabled);
@@ -273,3 +369,23 @@ void CMapItem::moveToBottom()
 
     map->emitSigCanvasUpdate();
 }
+
+void CMapItem::moveToActivationPosition()
+{
+    int row;
+    QTreeWidget * w = treeWidget();
+    QMutexLocker lock(&mutexActiveMaps);
+
+    w->takeTopLevelItem(w->indexOfTopLevelItem(this));
+    for(row = 0; row < w->topLevelItemCount(); row++)
+    {
+        CMapItem * item = dynamic_cast<CMapItem*>(w->topLevelItem(row));
+        if(item && (item->mapfile.isNull() || item->activationIdx > activationIdx))
+        {
+            break;
+        }
+    }
+    w->insertTopLevelItem(row, this);
+
+    map->emitSigCanvasUpdate();
+}
@@ -19,17 +19,21 @@
 #ifndef CMAPITEM_H
 #define CMAPITEM_H
 
+#include <QCoreApplication>
 #include <QMutex>
 #include <QPointer>
 #include <QTreeWidgetItem>
 
 class IMap;
+class CDrawObjectLoader;
 class CMapDraw;
 class CMapPropSetup;
+class QFont;
 class QSettings;
 
 class CMapItem : public QTreeWidgetItem
 {
+    Q_DECLARE_TR_FUNCTIONS(CMapItem)
 public:
     CMapItem(QTreeWidget * parent, CMapDraw *map);
     virtual ~CMapItem();
@@ -49,9 +53,19 @@ public:
        @return True if the internal list of map objects is not empty.
      */
     bool isActivated();
+    /**
+       @brief Query if the map is loaded in the background right now
+     */
+    bool isLoading() const
+    {
+        return loading;
+    }
     /**
        @brief Either loads or destroys internal map objects
-       @return True if the internal list of maps is not empty after the operation.
+
+       If the map is still loading in the background the loading is canceled.
+
+       @return True if the internal list of maps is not empty or the map is loading after the operation.
      */
     bool toggleActivate();
     /**
@@ -59,6 +73,14 @@ public:
      * @return Return true on success.
      */
     bool activate();
+    /**
+       @brief Load the map object in a worker thread
+
+       Formats with an expensive setup are loaded by a CDrawObjectLoader. The item
+       is added to the list of active maps as soon as the loader has finished. All
+       other formats are activated synchronously by activate().
+     */
+    void activateAsync();
     /**
        @brief Delete all internal map objects
      */
@@ -92,7 +114,35 @@ public:
 
     const QString& getKey(){return key;}
 
+    /**
+       @brief Create a map object by the file's suffix
+
+       @param filename  the map file
+       @param mapFont   the font for map labels, as CMainWindow must not be accessed by a worker thread
+       @param map       the draw context the map will be attached to
+       @return The map object or nullptr for unknown formats.
+     */
+    static IMap * createMap(const QString& filename, const QFont& mapFont, CMapDraw * map);
+
 private:
+    /// called in the GUI thread when the loader has finished
+    void finishLoading(CDrawObjectLoader * loader);
+    /// ignore the result of a running loader
+    void cancelLoading();
+    /// everything to be done after the map object has been created
+    bool setupActivated();
+    /**
+       @brief Move item to it's position in the list of active maps
+
+       Maps loaded in the background finish in random order. To keep the order
+       of activation the item is placed in front of all active items activated
+       after this one.
+     */
+    void moveToActivationPosition();
+
+    /// counter to track the order of activation
+    static quint32 activationCnt;
+
     CMapDraw * map;
     /**
        @brief A MD5 hash over the first 1024 bytes of the map file, to identify the map
@@ -106,6 +156,13 @@ private:
        @brief List of loaded map objects when map is activated.
      */
     QPointer<IMap> mapfile;
+
+    /// the position in the order of activation
+    quint32 activationIdx = 0;
+    /// true while the map is loaded by a worker thread
+    bool loading = false;
+    /// connection to the loader's finished() signal
+    QMetaObject::Connection connLoader;
 };
 
 #endif //CMAPITEM_H
@@ -18,6 +18,7 @@
 
 #include "helpers/CDraw.h"
 #include "inttypes.h"
+#include "map/cache/CMapIndexCache.h"
 #include "map/CMapDraw.h"
 #include "map/CMapJNX.h"
 #include "units/IUnit.h"
@@ -214,6 +215,13 @@ void CMapJNX::readFile(const QString& fn, qint32& productId)
         }
     }
 
+    // the tile tables are the bulk of the header. Try to get them from the index cache first.
+    if(restoreTileTables(fn, mapFile))
+    {
+        updateBoundaries(mapFile);
+        return;
+    }
+
     for(quint32 i = 0; i < hdr.details; i++)
     {
         level_t& level = mapFile.levels[i];
@@ -237,6 +245,12 @@ void CMapJNX::readFile(const QString& fn, qint32& productId)
         }
     }
 
+    storeTileTables(fn, mapFile);
+    updateBoundaries(mapFile);
+}
+
+void CMapJNX::updateBoundaries(const file_t& mapFile)
+{
     if(mapFile.lon1 < lon1)
     {
         lon1 = mapFile.lon1;
@@ -255,6 +269,77 @@ void CMapJNX::readFile(const QString& fn, qint32& productId)
     }
 }
 
+/// increase this if the stored tile tables change
+#define JNX_INDEX_VERSION 1
+
+void CMapJNX::storeTileTables(const QString& fn, const file_t& mapFile)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+
+    stream << quint32(mapFile.levels.size());
+    for(const level_t& level : mapFile.levels)
+    {
+        stream << quint32(level.tiles.size());
+        for(const tile_t& tile : level.tiles)
+        {
+            stream << tile.area << tile.width << tile.height << tile.size << tile.offset;
+        }
+    }
+
+    CMapIndexCache::store(fn, "JNX", JNX_INDEX_VERSION, data);
+}
+
+bool CMapJNX::restoreTileTables(const QString& fn, file_t& mapFile)
+{
+    QByteArray data;
+    if(!CMapIndexCache::restore(fn, "JNX", JNX_INDEX_VERSION, data))
+    {
+        return false;
+    }
+
+    QDataStream stream(&data, QIODevice::ReadOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+
+    quint32 nLevels = 0;
+    stream >> nLevels;
+    if(nLevels != quint32(mapFile.levels.size()))
+    {
+        return false;
+    }
+
+    QVector<QVector<tile_t> > tables(nLevels);
+    for(quint32 i = 0; i < nLevels; i++)
+    {
+        quint32 nTiles = 0;
+        stream >> nTiles;
+        if(stream.status() != QDataStream::Ok || nTiles != mapFile.levels[i].nTiles)
+        {
+            return false;
+        }
+
+        QVector<tile_t>& tiles = tables[i];
+        tiles.resize(nTiles);
+        for(tile_t& tile : tiles)
+        {
+            stream >> tile.area >> tile.width >> tile.height >> tile.size >> tile.offset;
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    for(quint32 i = 0; i < nLevels; i++)
+    {
+        mapFile.levels[i].tiles = tables[i];
+    }
+
+    return true;
+}
+
 qint32 CMapJNX::scale2level(qreal s, const file_t& file)
 {
     qint32 idxLvl    = NOIDX;
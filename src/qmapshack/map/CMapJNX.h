@@ -95,6 +95,9 @@ private:
     };
 
     void readFile(const QString& fn, qint32& productId);
+    void updateBoundaries(const file_t& mapFile);
+    void storeTileTables(const QString& fn, const file_t& mapFile);
+    bool restoreTileTables(const QString& fn, file_t& mapFile);
     qint32 scale2level(qreal s, const file_t& file);
 
     QList<file_t> files;
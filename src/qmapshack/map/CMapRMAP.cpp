@@ -18,6 +18,7 @@
 
 #include "CMainWindow.h"
 #include "helpers/CDraw.h"
+#include "map/cache/CMapIndexCache.h"
 #include "map/CMapDraw.h"
 #include "map/CMapRMAP.h"
 #include "units/IUnit.h"
@@ -45,7 +46,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
 
     if("CompeGPSRasterImage" != QString(charbuf))
     {
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("This is not a TwoNav RMAP file."), QMessageBox::Abort, QMessageBox::Abort);
+        reportLoadError(tr("Error..."), tr("This is not a TwoNav RMAP file."));
         return;
     }
 
@@ -54,7 +55,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
 
     if(tag1 != 10 || tag2 != 7)
     {
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Unknown sub-format."), QMessageBox::Abort, QMessageBox::Abort);
+        reportLoadError(tr("Error..."), tr("Unknown sub-format."));
         return;
     }
 
@@ -78,22 +79,28 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
         levels << level;
     }
 
-    for(int i = 0; i < levels.size(); i++)
+    // the tile offset tables are the bulk of the header. Try to get them from the index cache first.
+    if(!restoreLevels())
     {
-        level_t& level = levels[i];
-        file.seek(level.offsetLevel);
+        for(int i = 0; i < levels.size(); i++)
+        {
+            level_t& level = levels[i];
+            file.seek(level.offsetLevel);
 
-        stream >> level.width;
-        stream >> level.height;
-        stream >> level.xTiles;
-        stream >> level.yTiles;
+            stream >> level.width;
+            stream >> level.height;
+            stream >> level.xTiles;
+            stream >> level.yTiles;
 
-        for(int j = 0; j < (level.xTiles * level.yTiles); j++)
-        {
-            quint64 offset;
-            stream >> offset;
-            level.offsetJpegs << offset;
+            for(int j = 0; j < (level.xTiles * level.yTiles); j++)
+            {
+                quint64 offset;
+                stream >> offset;
+                level.offsetJpegs << offset;
+            }
         }
+
+        storeLevels();
     }
 
     file.seek(mapDataOffset);
@@ -124,7 +131,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
         {
             if(line.split("=")[1] != "2")
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Unknown version."), QMessageBox::Abort, QMessageBox::Abort);
+                reportLoadError(tr("Error..."), tr("Unknown version."));
                 return;
             }
         }
@@ -141,7 +148,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
             QStringList vals = line.split("=")[1].split(",");
             if(vals.size() < 5)
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to read reference point."), QMessageBox::Abort, QMessageBox::Abort);
+                reportLoadError(tr("Error..."), tr("Failed to read reference point."));
                 return;
             }
 
@@ -162,7 +169,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
             QStringList vals = line.split("=")[1].split(",");
             if(vals.size() < 5)
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to read reference point."), QMessageBox::Abort, QMessageBox::Abort);
+                reportLoadError(tr("Error..."), tr("Failed to read reference point."));
                 return;
             }
 
@@ -184,7 +191,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
             QStringList vals = line.split("=")[1].split(",");
             if(vals.size() < 5)
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to read reference point."), QMessageBox::Abort, QMessageBox::Abort);
+                reportLoadError(tr("Error..."), tr("Failed to read reference point."));
                 return;
             }
 
@@ -206,7 +213,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
             QStringList vals = line.split("=")[1].split(",");
             if(vals.size() < 5)
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to read reference point."), QMessageBox::Abort, QMessageBox::Abort);
+                reportLoadError(tr("Error..."), tr("Failed to read reference point."));
                 return;
             }
 
@@ -234,7 +241,7 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
     {
         if(!setProjection(projection, datum))
         {
-            QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Unknown projection and datum (%1%2).").arg(projection).arg(datum), QMessageBox::Abort, QMessageBox::Abort);
+            reportLoadError(tr("Error..."), tr("Unknown projection and datum (%1%2).").arg(projection).arg(datum));
             return;
         }
     }
@@ -342,6 +349,63 @@ CMapRMAP::CMapRMAP(const QString &filename, CMapDraw *parent)
 //    qDebug() << "scale x:  " << scale.x() << "y:" << scale.y();
 }
 
+/// increase this if the stored level tables change
+#define RMAP_INDEX_VERSION 1
+
+void CMapRMAP::storeLevels()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+
+    stream << qint32(levels.size());
+    for(const level_t& level : levels)
+    {
+        stream << level.offsetLevel << level.width << level.height << level.xTiles << level.yTiles << level.offsetJpegs;
+    }
+
+    CMapIndexCache::store(filename, "RMAP", RMAP_INDEX_VERSION, data);
+}
+
+bool CMapRMAP::restoreLevels()
+{
+    QByteArray data;
+    if(!CMapIndexCache::restore(filename, "RMAP", RMAP_INDEX_VERSION, data))
+    {
+        return false;
+    }
+
+    QDataStream stream(&data, QIODevice::ReadOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+
+    qint32 nLevels = 0;
+    stream >> nLevels;
+    if(nLevels != levels.size())
+    {
+        return false;
+    }
+
+    QList<level_t> tmpLevels;
+    for(qint32 i = 0; i < nLevels; i++)
+    {
+        level_t level;
+        stream >> level.offsetLevel >> level.width >> level.height >> level.xTiles >> level.yTiles >> level.offsetJpegs;
+        if(level.offsetLevel != levels[i].offsetLevel)
+        {
+            return false;
+        }
+        tmpLevels << level;
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    levels = tmpLevels;
+    return true;
+}
+
 bool CMapRMAP::setProjection(const QString& projection, const QString& datum)
 {
     QString projstr;
@@ -55,6 +55,8 @@ private:
     };
 
     bool setProjection(const QString& projection, const QString& datum);
+    void storeLevels();
+    bool restoreLevels();
     level_t& findBestLevel(const QPointF &s);
 
     QString filename;
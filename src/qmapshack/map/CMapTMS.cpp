@@ -315,7 +315,7 @@ void CMapTMS::draw(IDrawContext::buffer_t& buf) /* override */
     QMutexLocker lock(&mutex);
 
     timeLastUpdate.start();
-    urlQueue.clear();
+    CTileRequests requests(*this);
 
     if(map->needsRedraw())
     {
@@ -392,6 +392,9 @@ void CMapTMS::draw(IDrawContext::buffer_t& buf) /* override */
         row1 = lat2tile(y1 * RAD_TO_DEG, z) / 256;
         row2 = lat2tile(y2 * RAD_TO_DEG, z) / 256;
 
+        const qreal colCenter = lon2tile(buf.focus.x() * RAD_TO_DEG, z) / 256.0;
+        const qreal rowCenter = lat2tile(buf.focus.y() * RAD_TO_DEG, z) / 256.0;
+
 //        qDebug() << col1 << col2 << row1 << row2 << (col2 - col1) << (row2 - row1) << ((col2 - col1) * (row2 - row1));
 
         // start to request tiles. draw tiles in cache, queue urls of tile yet to be requested
@@ -419,11 +422,12 @@ void CMapTMS::draw(IDrawContext::buffer_t& buf) /* override */
                 }
                 else
                 {
-                    urlQueue << url;
+                    // request tiles close to the center of the viewport first
+                    const qreal dx = col + 0.5 - colCenter;
+                    const qreal dy = row + 0.5 - rowCenter;
+                    addTileRequest(url, dx * dx + dy * dy);
                 }
             }
         }
-
-        emit sigQueueChanged();
     }
 }
@@ -42,7 +42,7 @@ CMapVRT::CMapVRT(const QString &filename, CMapDraw *parent)
 
     if(nullptr == dataset)
     {
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to load file: %1").arg(filename));
+        reportLoadError(tr("Error..."), tr("Failed to load file: %1").arg(filename));
         return;
     }
 
@@ -56,7 +56,7 @@ CMapVRT::CMapVRT(const QString &filename, CMapDraw *parent)
         {
             GDALClose(dataset);
             dataset = nullptr;
-            QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("Failed to load file: %1").arg(filename));
+            reportLoadError(tr("Error..."), tr("Failed to load file: %1").arg(filename));
             return;
         }
 
@@ -80,7 +80,7 @@ CMapVRT::CMapVRT(const QString &filename, CMapDraw *parent)
         {
             GDALClose(dataset);
             dataset = nullptr;
-            QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("File must be 8 bit palette or gray indexed."));
+            reportLoadError(tr("Error..."), tr("File must be 8 bit palette or gray indexed."));
             return;
         }
 
@@ -137,7 +137,7 @@ CMapVRT::CMapVRT(const QString &filename, CMapDraw *parent)
     {
         delete dataset;
         dataset = nullptr;
-        QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Error..."), tr("No georeference information found."));
+        reportLoadError(tr("Error..."), tr("No georeference information found."));
         return;
     }
 
@@ -390,6 +390,14 @@ void CMapVRT::draw(IDrawContext::buffer_t& buf) /* override */
             dy *= 2;
             nTiles /= 4;
         }
+
+        // the preview reads from the next coarser overview
+        if(buf.preview)
+        {
+            dx *= 2;
+            dy *= 2;
+            nTiles /= 4;
+        }
     }
     else
     {
@@ -34,6 +34,12 @@ public:
 
     void draw(IDrawContext::buffer_t& buf) override;
 
+    bool hasPreview() const override
+    {
+        // the preview reads from a coarser overview
+        return hasOverviews;
+    }
+
 private:
     /**
        @brief Test subfiles of VRT for overviews
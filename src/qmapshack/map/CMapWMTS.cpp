@@ -373,7 +373,7 @@ void CMapWMTS::draw(IDrawContext::buffer_t& buf) /* override */
     QMutexLocker lock(&mutex);
 
     timeLastUpdate.start();
-    urlQueue.clear();
+    CTileRequests requests(*this);
 
     if(map->needsRedraw())
     {
@@ -495,6 +495,9 @@ void CMapWMTS::draw(IDrawContext::buffer_t& buf) /* override */
         qint32 col2 = qFloor((pt2.x() - tilematrix.topLeft.x()) / ( xscale * tilematrix.tileWidth));
         qint32 row2 = qFloor((pt2.y() - tilematrix.topLeft.y()) / ( yscale * tilematrix.tileHeight));
 
+        const qreal colCenter = ((pt1.x() + pt2.x()) / 2 - tilematrix.topLeft.x()) / ( xscale * tilematrix.tileWidth);
+        const qreal rowCenter = ((pt1.y() + pt2.y()) / 2 - tilematrix.topLeft.y()) / ( yscale * tilematrix.tileHeight);
+
 
         if(col1 < minCol)
         {
@@ -563,11 +566,12 @@ void CMapWMTS::draw(IDrawContext::buffer_t& buf) /* override */
                 }
                 else
                 {
-                    urlQueue << url;
+                    // request tiles close to the center of the viewport first
+                    const qreal dx = col + 0.5 - colCenter;
+                    const qreal dy = row + 0.5 - rowCenter;
+                    addTileRequest(url, dx * dx + dy * dy);
                 }
             }
         }
-
-        emit sigQueueChanged();
     }
 }
@@ -0,0 +1,139 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "map/CTileRequestScheduler.h"
+
+#include <QtCore>
+
+CTileRequestScheduler::CTileRequestScheduler(qint32 maxPendingPerHost)
+    : maxPendingPerHost(qMax(1, maxPendingPerHost))
+{
+}
+
+QString CTileRequestScheduler::hostOf(const QString& url)
+{
+    return QUrl(url).host();
+}
+
+void CTileRequestScheduler::beginCycle()
+{
+    queue.clear();
+    queued.clear();
+    wanted.clear();
+}
+
+bool CTileRequestScheduler::add(const QString& url, qreal priority)
+{
+    wanted << url;
+
+    if(queued.contains(url) || pending.contains(url))
+    {
+        stats.duplicates++;
+        return false;
+    }
+
+    queue << request_t {url, priority};
+    queued << url;
+    stats.queued++;
+    return true;
+}
+
+QStringList CTileRequestScheduler::endCycle()
+{
+    std::stable_sort(queue.begin(), queue.end(), [](const request_t& r1, const request_t& r2)
+    {
+        return r1.priority < r2.priority;
+    });
+
+    QStringList stale;
+    for(const QString& url : pending)
+    {
+        if(!wanted.contains(url))
+        {
+            stale << url;
+        }
+    }
+    return stale;
+}
+
+bool CTileRequestScheduler::takeNext(QString& url)
+{
+    const qint32 N = queue.size();
+    for(qint32 i = 0; i < N; i++)
+    {
+        QString host = hostOf(queue[i].url);
+        qint32& cnt = pendingPerHost[host];
+        if(cnt >= maxPendingPerHost)
+        {
+            continue;
+        }
+
+        url = queue.takeAt(i).url;
+        queued.remove(url);
+        pending << url;
+        cnt++;
+        stats.requested++;
+        return true;
+    }
+
+    return false;
+}
+
+void CTileRequestScheduler::release(const QString& url)
+{
+    pending.remove(url);
+
+    QString host = hostOf(url);
+    qint32& cnt = pendingPerHost[host];
+    if(--cnt <= 0)
+    {
+        pendingPerHost.remove(host);
+    }
+}
+
+bool CTileRequestScheduler::finished(const QString& url, bool error)
+{
+    if(!pending.contains(url))
+    {
+        return false;
+    }
+
+    release(url);
+    if(error)
+    {
+        stats.failed++;
+    }
+    else
+    {
+        stats.finished++;
+    }
+    return true;
+}
+
+bool CTileRequestScheduler::canceled(const QString& url)
+{
+    if(!pending.contains(url))
+    {
+        return false;
+    }
+
+    release(url);
+    stats.canceled++;
+    return true;
+}
+
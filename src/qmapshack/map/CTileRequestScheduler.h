@@ -0,0 +1,159 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CTILEREQUESTSCHEDULER_H
+#define CTILEREQUESTSCHEDULER_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+/**
+   @brief Book keeping of tile requests for online maps
+
+   The scheduler does not do any network access. It just decides which tile url
+   should be requested next. Tiles are ordered by a priority (lower values first),
+   that is usually the distance of the tile to the center of the viewport. The
+   number of concurrent requests is limited per host. Each draw of an online map
+   is a request cycle. Pending requests that are not part of the latest cycle
+   anymore are reported as stale and can be canceled.
+
+   @note The class is not thread safe. Access has to be serialized by the owner.
+ */
+class CTileRequestScheduler
+{
+public:
+    CTileRequestScheduler(qint32 maxPendingPerHost = 6);
+    virtual ~CTileRequestScheduler() = default;
+
+    struct stats_t
+    {
+        quint32 queued     = 0; //< total number of urls added to the queue
+        quint32 duplicates = 0; //< urls rejected because they have been queued or pending already
+        quint32 requested  = 0; //< urls handed out to be requested
+        quint32 finished   = 0; //< requests finished successfully
+        quint32 failed     = 0; //< requests finished with an error
+        quint32 canceled   = 0; //< requests canceled because they became stale
+    };
+
+    /**
+       @brief Start a new request cycle
+
+       All queued but not requested urls are dropped. Pending urls are kept but will
+       be reported as stale by endCycle() if they are not added again.
+     */
+    void beginCycle();
+    /**
+       @brief Add a tile url to the current cycle
+
+       @param url       the tile url
+       @param priority  the priority of the tile, lower values are requested first
+       @return False if the url has been rejected as it is queued or pending already.
+     */
+    bool add(const QString& url, qreal priority);
+    /**
+       @brief Finish the current request cycle
+
+       The queue is sorted by priority and all pending urls not added in this cycle
+       are collected as stale.
+
+       @return A list of stale urls that are still pending.
+     */
+    QStringList endCycle();
+
+    /**
+       @brief Get the next url to request
+
+       The url with the lowest priority value is returned, as long as its host
+       has not reached the limit of pending requests. The url is moved from the
+       queue into the set of pending urls.
+
+       @param url       the url to request
+       @return False if there is no url that can be requested right now.
+     */
+    bool takeNext(QString& url);
+
+    /// mark a pending url as finished, returns false if the url was not pending
+    bool finished(const QString& url, bool error);
+    /// mark a pending url as canceled, returns false if the url was not pending
+    bool canceled(const QString& url);
+
+    bool isPending(const QString& url) const
+    {
+        return pending.contains(url);
+    }
+
+    qint32 countQueued() const
+    {
+        return queue.size();
+    }
+
+    qint32 countPending() const
+    {
+        return pending.size();
+    }
+
+    bool isIdle() const
+    {
+        return queue.isEmpty() && pending.isEmpty();
+    }
+
+    const stats_t& getStats() const
+    {
+        return stats;
+    }
+
+    void setMaxPendingPerHost(qint32 n)
+    {
+        maxPendingPerHost = qMax(1, n);
+    }
+
+    qint32 getMaxPendingPerHost() const
+    {
+        return maxPendingPerHost;
+    }
+
+private:
+    static QString hostOf(const QString& url);
+    void release(const QString& url);
+
+    struct request_t
+    {
+        QString url;
+        qreal priority;
+    };
+
+    qint32 maxPendingPerHost;
+
+    /// all queued requests, sorted by priority after endCycle()
+    QList<request_t> queue;
+    /// the urls of all queued requests for fast lookup
+    QSet<QString> queued;
+    /// all urls requested but not finished yet
+    QSet<QString> pending;
+    /// all urls added during the current cycle
+    QSet<QString> wanted;
+    /// number of pending requests per host
+    QHash<QString, qint32> pendingPerHost;
+
+    stats_t stats;
+};
+
+#endif //CTILEREQUESTSCHEDULER_H
+
@@ -52,6 +52,15 @@ public:
 
     virtual void draw(IDrawContext::buffer_t& buf) = 0;
 
+    /**
+       @brief Test if draw() has a cheaper pass for IDrawContext::buffer_t::preview
+       @return Return true if the map draws faster with the preview flag set.
+     */
+    virtual bool hasPreview() const
+    {
+        return false;
+    }
+
     /**
        @brief Test if map has been loaded successfully
        @return Return false if map is not loaded
@@ -17,6 +17,7 @@
 
 **********************************************************************************************/
 
+#include "canvas/CRenderStats.h"
 #include "CMainWindow.h"
 #include "map/cache/CDiskCache.h"
 #include "map/CMapDraw.h"
@@ -51,34 +52,71 @@ bool IMapOnline::httpsCheck(const QString &url)
 }
 
 
+void IMapOnline::beginTileRequests()
+{
+    QMutexLocker lock(&mutex);
+    scheduler.beginCycle();
+}
+
+void IMapOnline::addTileRequest(const QString& url, qreal priority)
+{
+    QMutexLocker lock(&mutex);
+    scheduler.add(url, priority);
+}
+
+void IMapOnline::endTileRequests()
+{
+    QMutexLocker lock(&mutex);
+    urlStale = scheduler.endCycle();
+    lastRequest = !scheduler.isIdle();
+
+    emit sigQueueChanged();
+}
+
+CTileRequestScheduler::stats_t IMapOnline::getRequestStats()
+{
+    QMutexLocker lock(&mutex);
+    return scheduler.getStats();
+}
+
+void IMapOnline::getRequestQueueSize(qint32& queued, qint32& pending)
+{
+    QMutexLocker lock(&mutex);
+    queued  = scheduler.countQueued();
+    pending = scheduler.countPending();
+}
+
 void IMapOnline::slotQueueChanged()
 {
     QMutexLocker lock(&mutex);
 
-    if(!urlQueue.isEmpty() && urlPending.size() < 6)
+    // abort all requests of tiles that have left the viewport
+    const QStringList stale = urlStale;
+    urlStale.clear();
+    for(const QString& url : stale)
     {
-        // request up to 6 pending request
-        for(int i = 0; i < (6 - urlPending.size()); i++)
+        QNetworkReply * reply = replies.value(url, nullptr);
+        if(reply != nullptr)
         {
-            QString url = urlQueue.dequeue();
-            lastRequest = urlQueue.isEmpty();
-
-            QNetworkRequest request;
-            request.setUrl(url);
-            for(const rawHeaderItem_t &item : rawHeaderItems)
-            {
-                request.setRawHeader(item.name.toLatin1(), item.value.toLatin1());
-            }
-            accessManager->get(request);
-            urlPending << url;
-
-            if(lastRequest)
-            {
-                break;
-            }
+            // this will call slotRequestFinished() with QNetworkReply::OperationCanceledError
+            reply->abort();
         }
     }
-    else if(lastRequest && urlPending.isEmpty())
+
+    // request as many tiles as the scheduler allows
+    QString url;
+    while(scheduler.takeNext(url))
+    {
+        QNetworkRequest request;
+        request.setUrl(url);
+        for(const rawHeaderItem_t &item : rawHeaderItems)
+        {
+            request.setRawHeader(item.name.toLatin1(), item.value.toLatin1());
+        }
+        replies[url] = accessManager->get(request);
+    }
+
+    if(lastRequest && scheduler.isIdle())
     {
         lastRequest = false;
         // if all tiles are received the map layer can be redrawn with all tiles from cache
@@ -91,8 +129,14 @@ void IMapOnline::slotQueueChanged()
         map->emitSigCanvasUpdate();
     }
 
+    if(CRenderStats::isEnabled())
+    {
+        CRenderStats::setValue(name + "/queued", scheduler.countQueued());
+        CRenderStats::setValue(name + "/pending", scheduler.countPending());
+    }
+
     // report status of pending tiles
-    int pending = urlQueue.size() + urlPending.size();
+    int pending = scheduler.countQueued() + scheduler.countPending();
     if(pending)
     {
         map->reportStatusToCanvas(name, tr("<b>%1</b>: %2 tiles pending<br/>").arg(name).arg(pending));
@@ -109,7 +153,18 @@ void IMapOnline::slotRequestFinished(QNetworkReply* reply)
     QMutexLocker lock(&mutex);
 
     QString url = reply->url().toString();
-    if(urlPending.contains(url))
+    if(replies.value(url, nullptr) == reply)
+    {
+        replies.remove(url);
+    }
+
+    if(reply->error() == QNetworkReply::OperationCanceledError)
+    {
+        // a stale request has been aborted. Do not store anything to the cache as
+        // the tile would be marked as invalid.
+        scheduler.canceled(url);
+    }
+    else if(scheduler.isPending(url))
     {
         QImage img;
         // only take good responses
@@ -121,11 +176,11 @@ void IMapOnline::slotRequestFinished(QNetworkReply* reply)
         // always store image to cache, the cache will take care of NULL images
         diskCache->store(url, img);
 
-        urlPending.removeAll(url);
+        scheduler.finished(url, reply->error() != QNetworkReply::NoError);
     }
 
     // debug output any error
-    if(reply->error())
+    if(reply->error() && reply->error() != QNetworkReply::OperationCanceledError)
     {
         qDebug() << "Request to" << url << "failed:" << reply->errorString();
     }
@@ -19,9 +19,10 @@
 
 #ifndef IMAPONLINE_H
 #define IMAPONLINE_H
+#include "map/CTileRequestScheduler.h"
 #include "map/IMap.h"
+#include <QHash>
 #include <QMutex>
-#include <QQueue>
 #include <QTime>
 
 class CDiskCache;
@@ -46,14 +47,16 @@ signals:
 protected:
     /// Mutex to control access to url queue
     QMutex mutex {QMutex::Recursive};
-    /// a queue with all tile urls to request
-    QQueue<QString> urlQueue;
+    /// the scheduler to prioritize and limit tile requests
+    CTileRequestScheduler scheduler;
     /// the tile cache
     CDiskCache * diskCache = nullptr;
     /// access manager to request tiles
     QNetworkAccessManager * accessManager = nullptr;
-    QList<QString> urlPending;
-
+    /// all network replies still in progress
+    QHash<QString, QNetworkReply*> replies;
+    /// pending urls that are not part of the current viewport anymore
+    QStringList urlStale;
 
     bool lastRequest = false;
     QTime timeLastUpdate;
@@ -71,7 +74,57 @@ protected:
 
     void configureCache() override;
 
+    /**
+       @brief Start to collect the tile requests for a new viewport
+
+       Call this at the beginning of draw(). All tiles not requested yet are removed
+       from the queue.
+     */
+    void beginTileRequests();
+    /**
+       @brief Queue a tile url that is not in the cache
+
+       @param url       the tile's url
+       @param priority  the tile's priority, e.g. the squared distance to the viewport's center in tiles
+     */
+    void addTileRequest(const QString& url, qreal priority);
+    /**
+       @brief Finish collecting tile requests
+
+       Sort the queue by priority, mark requests of the previous viewport as stale
+       and trigger the request processing.
+     */
+    void endTileRequests();
+
+    /**
+       @brief Collect the tile requests of a draw() call
+
+       Calls beginTileRequests() on construction and endTileRequests() on destruction.
+       Thus the cycle is finished on every exit path of draw(), including early returns.
+     */
+    class CTileRequests
+    {
+public:
+        CTileRequests(IMapOnline& online) : online(online)
+        {
+            online.beginTileRequests();
+        }
+
+        ~CTileRequests()
+        {
+            online.endTileRequests();
+        }
+
+private:
+        IMapOnline& online;
+    };
+
 public:
+    /// get a copy of the request counters for diagnostics
+    CTileRequestScheduler::stats_t getRequestStats();
+    /// get the number of queued and pending tile requests
+    void getRequestQueueSize(qint32& queued, qint32& pending);
+
     void slotQueueChanged();
     void slotRequestFinished(QNetworkReply* reply);
 
@@ -16,6 +16,7 @@
 
 **********************************************************************************************/
 
+#include "canvas/CRenderStats.h"
 #include "CDiskCache.h"
 #include "map/CMapDraw.h"
 #include "version.h"
@@ -88,6 +89,10 @@ void CDiskCache::restore(const QString& key, QImage& img)
     if(cache.contains(hash))
     {
         img = cache[hash];
+        if(CRenderStats::isEnabled())
+        {
+            CRenderStats::addCount("tile cache/" + dir.dirName() + "/memory hit");
+        }
     }
     else if(table.contains(hash))
     {
@@ -96,10 +101,18 @@ void CDiskCache::restore(const QString& key, QImage& img)
         {
             cache[hash] = img;
         }
+        if(CRenderStats::isEnabled())
+        {
+            CRenderStats::addCount("tile cache/" + dir.dirName() + "/disk hit");
+        }
     }
     else
     {
         img = QImage();
+        if(CRenderStats::isEnabled())
+        {
+            CRenderStats::addCount("tile cache/" + dir.dirName() + "/miss");
+        }
     }
 }
 
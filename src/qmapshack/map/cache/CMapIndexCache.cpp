@@ -0,0 +1,124 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "map/cache/CMapIndexCache.h"
+#include "map/CMapDraw.h"
+
+#include <QtCore>
+
+#define INDEX_MAGIC     "QMSMapIndex"
+#define INDEX_VERSION   1
+#define INDEX_SUBDIR    "MapIndex"
+
+QString CMapIndexCache::indexFilename(const QString& filename, const QString& format)
+{
+    const QString& cacheRoot = CMapDraw::getCacheRoot();
+    if(cacheRoot.isEmpty())
+    {
+        return QString();
+    }
+
+    QDir dir(QDir(cacheRoot).absoluteFilePath(INDEX_SUBDIR));
+
+    QCryptographicHash md5(QCryptographicHash::Md5);
+    md5.addData(QFileInfo(filename).absoluteFilePath().toUtf8());
+
+    return dir.absoluteFilePath(QString("%1.%2").arg(QString(md5.result().toHex())).arg(format.toLower()));
+}
+
+bool CMapIndexCache::restore(const QString& filename, const QString& format, quint32 version, QByteArray& data)
+{
+    const QString& indexname = indexFilename(filename, format);
+    if(indexname.isEmpty())
+    {
+        return false;
+    }
+
+    QFile file(indexname);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    QByteArray magic;
+    quint32 indexVersion    = 0;
+    QString  storedFormat;
+    quint32 storedVersion   = 0;
+    QString  storedPath;
+    qint64 storedSize       = 0;
+    qint64 storedModified   = 0;
+
+    stream >> magic >> indexVersion;
+    if(magic != INDEX_MAGIC || indexVersion != INDEX_VERSION)
+    {
+        return false;
+    }
+
+    stream >> storedFormat >> storedVersion >> storedPath >> storedSize >> storedModified;
+
+    const QFileInfo fi(filename);
+    if((storedFormat != format) || (storedVersion != version)
+       || (storedPath != fi.absoluteFilePath())
+       || (storedSize != fi.size())
+       || (storedModified != fi.lastModified().toMSecsSinceEpoch()))
+    {
+        return false;
+    }
+
+    stream >> data;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+void CMapIndexCache::store(const QString& filename, const QString& format, quint32 version, const QByteArray& data)
+{
+    const QString& indexname = indexFilename(filename, format);
+    if(indexname.isEmpty())
+    {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(indexname).absolutePath());
+
+    // write to a temporary file first to never leave a truncated index behind
+    QSaveFile file(indexname);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Failed to write map index" << indexname << file.errorString();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    const QFileInfo fi(filename);
+    stream << QByteArray(INDEX_MAGIC) << quint32(INDEX_VERSION);
+    stream << format << version << fi.absoluteFilePath() << qint64(fi.size()) << qint64(fi.lastModified().toMSecsSinceEpoch());
+    stream << data;
+
+    if(!file.commit())
+    {
+        qWarning() << "Failed to write map index" << indexname << file.errorString();
+    }
+}
+
@@ -0,0 +1,66 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CMAPINDEXCACHE_H
+#define CMAPINDEXCACHE_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+   @brief Persistent storage of parsed map file structures
+
+   Some map formats need to parse quite a lot of tables just to get ready for
+   drawing. To speed up the next start the parsed structures can be serialized
+   by the map and stored in the index cache. An index entry is keyed by the map's
+   absolute path, file size and time of last modification. If the map file changes
+   the index entry is invalid and the map has to be parsed again.
+
+   The payload is completely up to the map implementation. The format tag and the
+   format version are used to reject an entry if the map's serialization changes.
+ */
+class CMapIndexCache
+{
+public:
+    /**
+       @brief Restore the index of a map file
+
+       @param filename  the map's filename
+       @param format    a tag of the map format, e.g. "IMG"
+       @param version   the version of the map's serialization
+       @param data      the payload as it has been stored
+       @return False if there is no valid index for the map.
+     */
+    static bool restore(const QString& filename, const QString& format, quint32 version, QByteArray& data);
+
+    /**
+       @brief Store the index of a map file
+
+       @param filename  the map's filename
+       @param format    a tag of the map format, e.g. "IMG"
+       @param version   the version of the map's serialization
+       @param data      the payload to store
+     */
+    static void store(const QString& filename, const QString& format, quint32 version, const QByteArray& data);
+
+private:
+    static QString indexFilename(const QString& filename, const QString& format);
+};
+
+#endif //CMAPINDEXCACHE_H
+
@@ -19,10 +19,8 @@
 
 **********************************************************************************************/
 
-#include "CMainWindow.h"
 #include "map/garmin/CGarminTyp.h"
 #include "units/IUnit.h"
-#include <QMessageBox>
 #include <QtCore>
 
 #include <stdio.h>
@@ -464,7 +462,7 @@ bool CGarminTyp::parsePolygon(QDataStream& in, QMap<quint32, polygon_property>&
         default:
             if(!tainted)
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Warning..."), tr("This is a typ file with unknown polygon encoding. Please report!"), QMessageBox::Abort, QMessageBox::Abort);
+                warnings << tr("This is a typ file with unknown polygon encoding. Please report!");
                 tainted = true;
             }
             qDebug() << "Failed polygon:" << typ << subtyp << hex << typ << subtyp << ctyp;
@@ -853,7 +851,7 @@ bool CGarminTyp::parsePolyline(QDataStream& in, QMap<quint32, polyline_property>
         default:
             if(!tainted)
             {
-                QMessageBox::warning(CMainWindow::getBestWidgetForParent(), tr("Warning..."), tr("This is a typ file with unknown polyline encoding. Please report!"), QMessageBox::Abort, QMessageBox::Abort);
+                warnings << tr("This is a typ file with unknown polyline encoding. Please report!");
                 tainted = true;
             }
 
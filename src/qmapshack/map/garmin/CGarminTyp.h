@@ -201,6 +201,17 @@ public:
         return pid;
     }
 
+    /**
+       @brief Get the problems found by decode()
+
+       decode() is called by the map loader threads, too. It must not
+       show any dialog. The caller has to report the warnings.
+     */
+    const QStringList& getWarnings() const
+    {
+        return warnings;
+    }
+
 protected:
     virtual bool parseHeader(QDataStream& in);
     virtual bool parseDrawOrder(QDataStream& in, QList<quint32>& drawOrder);
@@ -238,6 +249,8 @@ protected:
     quint16 fid = 0;
     quint16 pid = 0;
 
+    QStringList warnings;
+
     typ_section_t sectPoints;
     typ_section_t sectPolylines;
     typ_section_t sectPolygons;
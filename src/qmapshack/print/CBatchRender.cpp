@@ -0,0 +1,182 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "canvas/CCanvas.h"
+#include "gis/CGisWorkspace.h"
+#include "gis/prj/IGisProject.h"
+#include "print/CBatchRender.h"
+#include "print/CTiffWriter.h"
+#include "setup/CAppOpts.h"
+
+#include <iostream>
+#include <QtWidgets>
+
+int CBatchRender::exec()
+{
+    // reject all dialogs as nobody is there to answer them
+    QTimer timerDialogs;
+    QObject::connect(&timerDialogs, &QTimer::timeout, []()
+    {
+        QDialog * dlg = qobject_cast<QDialog*>(QApplication::activeModalWidget());
+        if(dlg != nullptr)
+        {
+            qWarning() << "Reject dialog" << dlg->windowTitle();
+            dlg->reject();
+        }
+    });
+    timerDialogs.start(100);
+
+    if(!QFileInfo(qlOpts->renderView).isReadable())
+    {
+        std::cerr << tr("Failed to read view %1").arg(qlOpts->renderView).toUtf8().constData() << std::endl;
+        return 1;
+    }
+
+    QRectF area = loadOverlays();
+    if(qlOpts->renderArea.isValid())
+    {
+        area = QRectF(qlOpts->renderArea.topLeft() * DEG_TO_RAD, qlOpts->renderArea.bottomRight() * DEG_TO_RAD);
+    }
+
+    if(area.isEmpty())
+    {
+        std::cerr << tr("There is no area to render. Use --bbox or pass files with data.").toUtf8().constData() << std::endl;
+        return 1;
+    }
+
+    // Each canvas draws a tile in its own threads
+    const int N = qMax(1, QThread::idealThreadCount() / 2);
+    QList<CCanvas*> canvases;
+    for(int n = 0; n < N; n++)
+    {
+        CCanvas * canvas = new CCanvas(nullptr, QString("Render %1").arg(n + 1));
+        QSettings view(qlOpts->renderView, QSettings::IniFormat);
+        canvas->loadConfig(view);
+
+        if(qlOpts->renderSize.isValid())
+        {
+            canvas->zoomTo(area, qlOpts->renderSize);
+        }
+
+        canvases << canvas;
+    }
+
+    const bool success = save(canvases, area);
+
+    qDeleteAll(canvases);
+
+    return success ? 0 : 1;
+}
+
+QRectF CBatchRender::loadOverlays()
+{
+    QRectF area;
+    for(const QString& filename : qlOpts->arguments)
+    {
+        IGisProject * project = CGisWorkspace::self().loadGisProject(filename);
+        if(project == nullptr)
+        {
+            std::cerr << tr("Failed to load %1").arg(filename).toUtf8().constData() << std::endl;
+            continue;
+        }
+
+        for(int i = 0; i < project->childCount(); i++)
+        {
+            IGisItem * item = dynamic_cast<IGisItem*>(project->child(i));
+            if(item != nullptr)
+            {
+                area = area.united(item->getBoundingRect().normalized());
+            }
+        }
+    }
+
+    // add a small border around the data
+    const qreal dx = area.width() * 0.05;
+    const qreal dy = area.height() * 0.05;
+    return area.adjusted(-dx, -dy, dx, dy);
+}
+
+bool CBatchRender::save(const QList<CCanvas*>& canvases, const QRectF& area)
+{
+    CCanvas * canvas = canvases.first();
+
+    // get the area in pixel of the view's scale
+    QPolygonF corners;
+    corners << area.topLeft() << area.topRight() << area.bottomRight() << area.bottomLeft();
+    for(QPointF& pt : corners)
+    {
+        canvas->convertRad2Px(pt);
+    }
+
+    const QRectF& rectPx = corners.boundingRect();
+    const QSize size(qCeil(rectPx.width()), qCeil(rectPx.height()));
+
+    QPointF focus = rectPx.center();
+    QPointF topLeft = rectPx.topLeft();
+    QPointF bottomRight = rectPx.topLeft() + QPointF(size.width(), size.height());
+    canvas->convertPx2Rad(focus);
+    canvas->convertPx2Rad(topLeft);
+    canvas->convertPx2Rad(bottomRight);
+
+    const QString& filename = qlOpts->renderFile;
+    const QString& suffix = QFileInfo(filename).suffix().toLower();
+
+    qDebug() << "Render" << filename << "with" << size << "px on" << canvases.size() << "canvases";
+
+    if(suffix == "tif" || suffix == "tiff")
+    {
+        CTiffWriter writer(filename, size);
+        writer.setGeoReference(canvas->getProjection(), topLeft, bottomRight);
+
+        const bool success = CCanvas::printTiles(canvases, size, focus, true, [&writer](const QImage& img, const QPoint& pos)
+        {
+            return writer.write(img, pos);
+        });
+
+        writer.close(!success);
+        if(!success)
+        {
+            std::cerr << writer.getLastError().toUtf8().constData() << std::endl;
+        }
+        return success;
+    }
+
+    QImage img(size, QImage::Format_ARGB32);
+    if(img.isNull())
+    {
+        std::cerr << tr("The image is too large. Use a *.tif file instead.").toUtf8().constData() << std::endl;
+        return false;
+    }
+    img.fill(Qt::transparent);
+
+    QPainter p(&img);
+    CCanvas::printTiles(canvases, size, focus, true, [&p](const QImage& tile, const QPoint& pos)
+    {
+        p.drawImage(pos, tile);
+        return true;
+    });
+    p.end();
+
+    if(!img.save(filename))
+    {
+        std::cerr << tr("Failed to write %1").arg(filename).toUtf8().constData() << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,55 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CBATCHRENDER_H
+#define CBATCHRENDER_H
+
+#include <QCoreApplication>
+#include <QRectF>
+
+class CCanvas;
+
+/**
+   @brief Render an image without GUI
+
+   Used by the command line option --render. The maps, DEM, projection and
+   scale are taken from a view file. The files passed on the command line
+   are loaded as overlays. The image is rendered tile by tile on several
+   canvases in parallel. Nobody is there to answer dialogs. Therefore all
+   dialogs are rejected.
+ */
+class CBatchRender
+{
+    Q_DECLARE_TR_FUNCTIONS(CBatchRender)
+public:
+    CBatchRender() = default;
+    virtual ~CBatchRender() = default;
+
+    /**
+       @brief Render the image as defined by the command line options
+
+       @return The exit code of the application
+     */
+    int exec();
+
+private:
+    QRectF loadOverlays();
+    bool save(const QList<CCanvas*>& canvases, const QRectF& area);
+};
+
+#endif //CBATCHRENDER_H
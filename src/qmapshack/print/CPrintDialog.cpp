@@ -26,6 +26,7 @@
 #include "helpers/CProgressDialog.h"
 #include "helpers/CSettings.h"
 #include "print/CPrintDialog.h"
+#include "print/CTiffWriter.h"
 
 #include <QtPrintSupport>
 #include <QtWidgets>
@@ -231,13 +232,14 @@ void CPrintDialog::slotPrint()
         {
             first = false;
         }
+        // large pages are rendered tile by tile to limit the memory used
         if(printScaleOnAllPages || pt == centers.last())
         {
-            canvas->print(p, rectPage, pt, true);
+            canvas->printTiled(p, rectPage, pt, true);
         }
         else
         {
-            canvas->print(p, rectPage, pt, false);
+            canvas->printTiled(p, rectPage, pt, false);
         }
         PROGRESS(++n, break);
     }
@@ -256,20 +258,15 @@ void CPrintDialog::slotSave()
     canvas->convertRad2Px(pt2);
 
     QRectF rect(pt1, pt2);
-    QImage img(rect.size().toSize(), QImage::Format_ARGB32);
-
-    QPainter p(&img);
-    USE_ANTI_ALIASING(p, true);
-
-    canvas->print(p, rect, rectSelArea.center());
 
     SETTINGS;
     QString path = cfg.value("Paths/lastImagePath", "./").toString();
 
     QString filterPNG = "PNG Image (*.png)";
     QString filterJPG = "JPEG Image (*.jpg)";
+    QString filterTIF = "TIFF Image (*.tif)";
     QString filter    = filterPNG;
-    QString filename = QFileDialog::getSaveFileName(this, tr("Save map..."), path, filterPNG + ";; " + filterJPG, &filter);
+    QString filename = QFileDialog::getSaveFileName(this, tr("Save map..."), path, filterPNG + ";; " + filterJPG + ";; " + filterTIF, &filter);
     if(filename.isEmpty())
     {
         return;
@@ -284,6 +281,10 @@ void CPrintDialog::slotSave()
     {
         expectedSuffix = "jpg";
     }
+    else if(filter == filterTIF)
+    {
+        expectedSuffix = "tif";
+    }
 
     QFileInfo fi(filename);
     if(fi.suffix().toLower() != expectedSuffix)
@@ -291,7 +292,27 @@ void CPrintDialog::slotSave()
         filename += "." + expectedSuffix;
     }
 
-    img.save(filename);
+    if(expectedSuffix == "tif")
+    {
+        // the image is streamed into the file tile by tile
+        if(!saveTiff(filename, rect.size().toSize(), rectSelArea.center()))
+        {
+            return;
+        }
+    }
+    else
+    {
+        QImage img(rect.size().toSize(), QImage::Format_ARGB32);
+        img.fill(Qt::transparent);
+
+        QPainter p(&img);
+        USE_ANTI_ALIASING(p, true);
+
+        canvas->printTiled(p, QRectF(QPointF(0, 0), rect.size()), rectSelArea.center());
+        p.end();
+
+        img.save(filename);
+    }
 
     cfg.setValue("Paths/lastImagePath", fi.absolutePath());
 
@@ -302,3 +323,37 @@ void CPrintDialog::slotScaleOnAllChanged(bool checked)
 {
     printScaleOnAllPages = checked;
 }
+
+bool CPrintDialog::saveTiff(const QString& filename, const QSize& size, const QPointF& focus)
+{
+    CTiffWriter writer(filename, size);
+    if(!writer.isValid())
+    {
+        QMessageBox::critical(this, tr("Error..."), writer.getLastError(), QMessageBox::Ok);
+        return false;
+    }
+
+    PROGRESS_SETUP(tr("Saving image."), 0, size.height(), this);
+
+    bool errWrite = false;
+    const bool done = canvas->printTiles(size, focus, true, [&](const QImage& img, const QPoint& pos)
+    {
+        if(!writer.write(img, pos))
+        {
+            errWrite = true;
+            return false;
+        }
+
+        PROGRESS(pos.y(), return false);
+        return true;
+    });
+
+    writer.close(!done);
+
+    if(errWrite)
+    {
+        QMessageBox::critical(this, tr("Error..."), writer.getLastError(), QMessageBox::Ok);
+    }
+
+    return done;
+}
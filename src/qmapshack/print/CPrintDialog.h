@@ -51,6 +51,15 @@ private slots:
 
 private:
     void updateMetrics();
+    /**
+       @brief Stream the selected area into a tiled TIFF file
+
+       @param filename  the file to create
+       @param size      the image size in [px]
+       @param focus     the center of the area in [rad]
+       @return False on error or if canceled by the user
+     */
+    bool saveTiff(const QString& filename, const QSize& size, const QPointF& focus);
 
     type_e type;
 
@@ -0,0 +1,140 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "print/CTiffWriter.h"
+
+#include <gdal_priv.h>
+#include <ogr_spatialref.h>
+#include <proj_api.h>
+#include <QtCore>
+
+CTiffWriter::CTiffWriter(const QString& filename, const QSize& size)
+    : filename(filename)
+    , size(size)
+{
+    GDALDriver * driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if(driver == nullptr)
+    {
+        lastError = tr("The GDAL driver for TIFF files is missing.");
+        return;
+    }
+
+    char ** options = nullptr;
+    options = CSLSetNameValue(options, "TILED", "YES");
+    options = CSLSetNameValue(options, "COMPRESS", "DEFLATE");
+    options = CSLSetNameValue(options, "BIGTIFF", "IF_SAFER");
+    options = CSLSetNameValue(options, "ALPHA", "YES");
+
+    dataset = driver->Create(filename.toUtf8(), size.width(), size.height(), 4, GDT_Byte, options);
+    CSLDestroy(options);
+
+    if(dataset == nullptr)
+    {
+        lastError = tr("Failed to create file '%1'.").arg(filename);
+    }
+}
+
+CTiffWriter::~CTiffWriter()
+{
+    close();
+}
+
+void CTiffWriter::setGeoReference(const QString& proj, const QPointF& topLeft, const QPointF& bottomRight)
+{
+    if(dataset == nullptr)
+    {
+        return;
+    }
+
+    projPJ pjsrc = pj_init_plus("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs");
+    projPJ pjtar = pj_init_plus(proj.toLatin1().data());
+    if(pjtar == nullptr)
+    {
+        pj_free(pjsrc);
+        return;
+    }
+
+    double x1 = topLeft.x();
+    double y1 = topLeft.y();
+    double x2 = bottomRight.x();
+    double y2 = bottomRight.y();
+    pj_transform(pjsrc, pjtar, 1, 0, &x1, &y1, nullptr);
+    pj_transform(pjsrc, pjtar, 1, 0, &x2, &y2, nullptr);
+
+    if(pj_is_latlong(pjtar))
+    {
+        x1 *= RAD_TO_DEG;
+        y1 *= RAD_TO_DEG;
+        x2 *= RAD_TO_DEG;
+        y2 *= RAD_TO_DEG;
+    }
+
+    pj_free(pjtar);
+    pj_free(pjsrc);
+
+    double geoTransform[6] = {x1, (x2 - x1) / size.width(), 0, y1, 0, (y2 - y1) / size.height()};
+    dataset->SetGeoTransform(geoTransform);
+
+    OGRSpatialReference srs;
+    if(srs.importFromProj4(proj.toLatin1().data()) == OGRERR_NONE)
+    {
+        char * wkt = nullptr;
+        srs.exportToWkt(&wkt);
+        dataset->SetProjection(wkt);
+        CPLFree(wkt);
+    }
+}
+
+bool CTiffWriter::write(const QImage& img, const QPoint& pos)
+{
+    if(dataset == nullptr)
+    {
+        return false;
+    }
+
+    // RGBA8888 has the same byte order on all platforms
+    const QImage& rgba = img.convertToFormat(QImage::Format_RGBA8888);
+    int bands[] = {1, 2, 3, 4};
+
+    CPLErr err = dataset->RasterIO(GF_Write, pos.x(), pos.y(), rgba.width(), rgba.height()
+                                   , const_cast<uchar*>(rgba.constBits()), rgba.width(), rgba.height(), GDT_Byte
+                                   , 4, bands, 4, rgba.bytesPerLine(), 1);
+    if(err != CE_None)
+    {
+        lastError = tr("Failed to write file '%1'.").arg(filename);
+        return false;
+    }
+
+    return true;
+}
+
+void CTiffWriter::close(bool remove)
+{
+    if(dataset == nullptr)
+    {
+        return;
+    }
+
+    GDALClose(dataset);
+    dataset = nullptr;
+
+    if(remove)
+    {
+        QFile::remove(filename);
+    }
+}
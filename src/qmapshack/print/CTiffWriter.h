@@ -0,0 +1,79 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CTIFFWRITER_H
+#define CTIFFWRITER_H
+
+#include <QCoreApplication>
+#include <QImage>
+
+class GDALDataset;
+
+/**
+   @brief Stream images tile by tile into a TIFF file
+
+   The file is written as tiled and compressed RGBA TIFF. As each tile is
+   written as soon as it is passed, the memory used does not depend on the
+   image's size.
+ */
+class CTiffWriter
+{
+    Q_DECLARE_TR_FUNCTIONS(CTiffWriter)
+public:
+    CTiffWriter(const QString& filename, const QSize& size);
+    virtual ~CTiffWriter();
+
+    bool isValid() const
+    {
+        return dataset != nullptr;
+    }
+
+    const QString& getLastError() const
+    {
+        return lastError;
+    }
+
+    /**
+       @brief Make the file a GeoTIFF
+
+       @param proj          the projection used to render the image as proj4 string
+       @param topLeft       the top left corner of the image in [rad]
+       @param bottomRight   the bottom right corner of the image in [rad]
+     */
+    void setGeoReference(const QString& proj, const QPointF& topLeft, const QPointF& bottomRight);
+
+    /**
+       @brief Write a tile into the file
+
+       @param img   the tile's image
+       @param pos   the tile's offset in the image in [px]
+       @return False on error.
+     */
+    bool write(const QImage& img, const QPoint& pos);
+
+    /// close the file. The file is removed if remove is true.
+    void close(bool remove = false);
+
+private:
+    QString filename;
+    QSize size;
+    GDALDataset * dataset = nullptr;
+    QString lastError;
+};
+
+#endif //CTIFFWRITER_H
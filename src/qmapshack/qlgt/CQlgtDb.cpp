@@ -41,6 +41,7 @@
 
 #define DB_QLGT_VERSION 9
 
+
 CQlgtDb::CQlgtDb(const QString &filename, CImportDatabase *parent)
     : gui(parent)
     , nItems(0)
@@ -595,7 +596,7 @@ void CQlgtDb::printStatistic()
     }
 }
 
-void CQlgtDb::start(const QString& filename)
+void CQlgtDb::start(const QString& filename, bool bulk)
 {
     gui->stdOut(tr("------ Start to convert database to %1------").arg(filename));
     dbQms = new CQmsDb(filename, gui);
@@ -607,7 +608,14 @@ void CQlgtDb::start(const QString& filename)
     }
 
 
-    xferItems();
+    if(bulk)
+    {
+        xferItemsBulk();
+    }
+    else
+    {
+        xferItems();
+    }
     xferFolders();
 
     QSqlQuery query(db);
@@ -689,73 +697,176 @@ void CQlgtDb::xferItems()
     QUERY_EXEC(return );
 }
 
-void CQlgtDb::xferItem(quint64 id)
+void CQlgtDb::xferItemsBulk()
 {
+    nWpt = 0;
+    nTrk = 0;
+    nRte = 0;
+    nOvl = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    quint64 bytes   = 0;
+    quint32 nStored = 0;
+
+    PROGRESS_SETUP(tr("Copy items..."), 0, nItems, gui);
+    dbQms->beginBulk();
+
+    // stream all items instead of reading them one by one
     QSqlQuery query(db);
-    query.prepare("SELECT type, data FROM items WHERE id=:id");
-    query.bindValue(":id", id);
-    QUERY_EXEC(return );
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, type, data FROM items");
+    QUERY_EXEC(NO_CMD);
 
-    if(query.next())
+    while(query.next())
     {
-        QByteArray data = query.value(1).toByteArray();
-        QDataStream stream(&data, QIODevice::ReadOnly);
-        stream.setVersion(QDataStream::Qt_4_5);
+        PROGRESS(nStored, break);
 
+        const quint64 id    = query.value(0).toULongLong();
+        const qint32 type   = query.value(1).toInt();
+        QByteArray data     = query.value(2).toByteArray();
+        bytes += data.size();
 
-        switch(query.value(0).toInt())
+        CQmsDb::item_t item;
+        QString error;
+        if(convertItem(id, type, data, item, error))
         {
-        case eWpt:
+            dbQms->addItem(item);
+        }
+        else if(!error.isEmpty())
         {
-            CQlgtWpt wpt1(id, 0);
-            stream >> wpt1;
-            dbQms->addWpt(wpt1);
-            nWpt++;
-            break;
+            gui->stdErr(error);
         }
+        countItem(type, item);
+        nStored++;
+    }
+
+    dbQms->endBulk();
+    progress.setValue(nItems);
+
+    const qreal seconds = qMax(timer.elapsed(), qint64(1)) / 1000.0;
+    gui->stdOut(tr("Imported %1 tracks, %2 waypoints, %3 routes, %4 areas").arg(nTrk).arg(nWpt).arg(nRte).arg(nOvl));
+    gui->stdOut(tr("Converted %1 items (%2 MB) in %3 s: %4 items/s, %5 MB/s")
+                .arg(nStored)
+                .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1)
+                .arg(seconds, 0, 'f', 1)
+                .arg(nStored / seconds, 0, 'f', 0)
+                .arg(bytes / (1024.0 * 1024.0) / seconds, 0, 'f', 1));
+    gui->stdOut(tr("Import folders..."));
+}
+
+void CQlgtDb::countItem(qint32 type, const CQmsDb::item_t& item)
+{
+    switch(type)
+    {
+    case eWpt:
+        nWpt++;
+        break;
+
+    case eTrk:
+        nTrk++;
+        break;
+
+    case eRte:
+        nRte++;
+        break;
 
-        case eTrk:
+    case eOvl:
+        // distance lines are converted to tracks
+        if(item.type == IGisItem::eTypeTrk)
         {
-            CQlgtTrack trk1(id, 0);
-            stream >> trk1;
-            dbQms->addTrk(trk1);
             nTrk++;
-            break;
         }
-
-        case eRte:
+        else
         {
-            CQlgtRoute rte1(id, 0);
-            stream >> rte1;
-            dbQms->addRte(rte1);
-            nRte++;
-            break;
+            nOvl++;
         }
+        break;
+    }
+}
 
-        case eOvl:
+void CQlgtDb::xferItem(quint64 id)
+{
+    QSqlQuery query(db);
+    query.prepare("SELECT type, data FROM items WHERE id=:id");
+    query.bindValue(":id", id);
+    QUERY_EXEC(return );
+
+    if(query.next())
+    {
+        const qint32 type = query.value(0).toInt();
+
+        CQmsDb::item_t item;
+        QString error;
+        if(convertItem(id, type, query.value(1).toByteArray(), item, error))
         {
-            IQlgtOverlay ovl1(id, 0);
-            stream >> ovl1;
-            if(ovl1.type == "Area")
-            {
-                dbQms->addArea(ovl1);
-                nOvl++;
-            }
-            else if(ovl1.type == "Distance")
-            {
-                dbQms->addTrk(ovl1);
-                nTrk++;
-            }
-            else
-            {
-                gui->stdErr(tr("Overlay of type '%1' cant be converted").arg(ovl1.type));
-                nOvl++;
-                break;
-            }
+            dbQms->addItem(item);
+        }
+        else if(!error.isEmpty())
+        {
+            gui->stdErr(error);
+        }
+        countItem(type, item);
+    }
+}
 
+bool CQlgtDb::convertItem(quint64 id, qint32 type, QByteArray blob, CQmsDb::item_t& item, QString& error)
+{
+    QDataStream stream(&blob, QIODevice::ReadOnly);
+    stream.setVersion(QDataStream::Qt_4_5);
 
-            break;
+    item.idQlgt = id;
+
+    switch(type)
+    {
+    case eWpt:
+    {
+        CQlgtWpt wpt1(id, 0);
+        stream >> wpt1;
+        CGisItemWpt wpt(wpt1);
+        CQmsDb::serialize(wpt, item);
+        return true;
+    }
+
+    case eTrk:
+    {
+        CQlgtTrack trk1(id, 0);
+        stream >> trk1;
+        CGisItemTrk trk(trk1);
+        CQmsDb::serialize(trk, item);
+        return true;
+    }
+
+    case eRte:
+    {
+        CQlgtRoute rte1(id, 0);
+        stream >> rte1;
+        CGisItemRte rte(rte1);
+        CQmsDb::serialize(rte, item);
+        return true;
+    }
+
+    case eOvl:
+    {
+        IQlgtOverlay ovl1(id, 0);
+        stream >> ovl1;
+        if(ovl1.type == "Area")
+        {
+            CGisItemOvlArea ovl(ovl1);
+            CQmsDb::serialize(ovl, item);
+            return true;
         }
+        else if(ovl1.type == "Distance")
+        {
+            CGisItemTrk trk(ovl1);
+            CQmsDb::serialize(trk, item);
+            return true;
         }
+
+        error = tr("Overlay of type '%1' cant be converted").arg(ovl1.type);
+        break;
     }
+    }
+
+    return false;
 }
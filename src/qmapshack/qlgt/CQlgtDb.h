@@ -19,6 +19,8 @@
 #ifndef CQLGTDB_H
 #define CQLGTDB_H
 
+#include "qlgt/CQmsDb.h"
+
 #include <QCoreApplication>
 #include <QDir>
 #include <QObject>
@@ -27,7 +29,6 @@
 #include <QTreeWidgetItem>
 
 class CImportDatabase;
-class CQmsDb;
 
 class CQlgtDb : public QObject
 {
@@ -52,7 +53,28 @@ public:
     CQlgtDb(const QString& filename, CImportDatabase * parent);
     virtual ~CQlgtDb();
 
-    void start(const QString& filename);
+    /**
+       @brief Convert the QLGT database into a new QMS database
+
+       @param filename  the filename of the QMS database
+       @param bulk      if true stream the items and store them in large transactions
+     */
+    void start(const QString& filename, bool bulk);
+
+    /**
+       @brief Convert a QLGT item blob into a QMS database record
+
+       The QMS items and their icons are built with QPixmap. Therefore this has
+       to be called by the GUI thread.
+
+       @param id        the item's ID in the QLGT database
+       @param type      the item's QLGT type
+       @param blob      the item's data as stored in the QLGT database
+       @param item      the record to fill
+       @param error     an error message if the item can't be converted
+       @return True if the item has been converted.
+     */
+    static bool convertItem(quint64 id, qint32 type, QByteArray blob, CQmsDb::item_t& item, QString& error);
 
 private:
     void initDB();
@@ -60,7 +82,10 @@ private:
     void printStatistic();
     void xferFolders();
     void xferItems();
+    void xferItemsBulk();
     void xferItem(quint64 id);
+    void countItem(qint32 type, const CQmsDb::item_t& item);
+
     QSqlDatabase db;
     QDir path;
     QString name;
@@ -26,16 +26,19 @@
 #include "gis/wpt/CGisItemWpt.h"
 #include "qlgt/CQlgtDb.h"
 #include "qlgt/CQlgtFolder.h"
-#include "qlgt/CQlgtRoute.h"
-#include "qlgt/CQlgtTrack.h"
-#include "qlgt/CQlgtWpt.h"
 #include "qlgt/CQmsDb.h"
-#include "qlgt/IQlgtOverlay.h"
 #include "tool/CImportDatabase.h"
 
+#include <proj_api.h>
 #include <QtSql>
 #include <QtWidgets>
 
+/// number of items inserted by a single transaction in bulk mode
+#define QMSDB_BULK_SIZE 1000
+
+#define QMSDB_INSERT_ITEM "INSERT INTO items (type, keyqms, icon, name, date, comment, data, hash) VALUES (:type, :keyqms, :icon, :name, :date, :comment, :data, :hash)"
+#define QMSDB_INSERT_AREA "INSERT OR REPLACE INTO itemarea (id, west, east, south, north) VALUES (:id, :west, :east, :south, :north)"
+
 CQmsDb::CQmsDb(const QString &filename, CImportDatabase *parent)
     : QObject(parent)
     , valid(false)
@@ -69,6 +72,7 @@ CQmsDb::CQmsDb(const QString &filename, CImportDatabase *parent)
 
 CQmsDb::~CQmsDb()
 {
+    endBulk();
     db.close();
 }
 
@@ -193,88 +197,131 @@ void CQmsDb::addFolder(CQlgtFolder& folder)
     mapFolderIDs[folder.id] = id;
 }
 
-void CQmsDb::addWpt(CQlgtWpt& wpt1)
+void CQmsDb::serialize(IGisItem& item, item_t& record)
 {
-    CGisItemWpt wpt(wpt1);
-    quint64 id = store(wpt);
-    if(id != 0)
-    {
-        mapItemIDs[wpt1.id] = id;
-    }
+    // serialize complete history of item
+    QDataStream in(&record.data, QIODevice::WriteOnly);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setVersion(QDataStream::Qt_5_2);
+    in << item.getHistory();
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    QPixmap pixmap = item.getDisplayIcon();
+    pixmap.save(&buffer, "PNG");
+
+    record.type     = item.type();
+    record.keyqms   = item.getKey().item;
+    record.icon     = buffer.data();
+    record.name     = item.getName();
+    record.date     = item.getTimestamp();
+    record.comment  = item.getInfo(IGisItem::eFeatureShowName | IGisItem::eFeatureShowFullText);
+    record.hash     = item.getHash();
+    record.area     = item.getBoundingRect();
 }
 
-void CQmsDb::addTrk(CQlgtTrack &trk1)
+void CQmsDb::addItem(const item_t& item)
 {
-    CGisItemTrk trk(trk1);
-    quint64 id = store(trk);
-    if(id != 0)
+    quint64 id = 0;
+    if(bulk)
     {
-        mapItemIDs[trk1.id] = id;
-    }
-}
+        id = store(queryBulkItem, queryBulkArea, item);
 
-void CQmsDb::addTrk(IQlgtOverlay &trk1)
-{
-    CGisItemTrk trk(trk1);
-    quint64 id = store(trk);
-    if(id != 0)
+        if(++cntBulk == QMSDB_BULK_SIZE)
+        {
+            QSqlQuery query(db);
+            QUERY_RUN("COMMIT TRANSACTION", NO_CMD);
+            QUERY_RUN("BEGIN TRANSACTION", NO_CMD);
+            cntBulk = 0;
+        }
+    }
+    else
     {
-        mapItemIDs[trk1.id] = id;
+        QSqlQuery queryItem(db);
+        queryItem.prepare(QMSDB_INSERT_ITEM);
+        QSqlQuery queryArea(db);
+        queryArea.prepare(QMSDB_INSERT_AREA);
+        id = store(queryItem, queryArea, item);
     }
-}
 
-void CQmsDb::addRte(CQlgtRoute& rte1)
-{
-    CGisItemRte rte(rte1);
-    quint64 id = store(rte);
     if(id != 0)
     {
-        mapItemIDs[rte1.id] = id;
+        mapItemIDs[item.idQlgt] = id;
     }
 }
 
-void CQmsDb::addArea(IQlgtOverlay& ovl1)
+void CQmsDb::beginBulk()
 {
-    CGisItemOvlArea ovl(ovl1);
-    quint64 id = store(ovl);
-    if(id != 0)
+    if(bulk)
     {
-        mapItemIDs[ovl1.id] = id;
+        return;
     }
+
+    QSqlQuery query(db);
+    // the target database is created from scratch. If something fails
+    // the conversion has to be repeated anyway.
+    QUERY_RUN("PRAGMA synchronous", NO_CMD);
+    synchronous = query.next() ? query.value(0).toString() : "2";
+    QUERY_RUN("PRAGMA synchronous=OFF", NO_CMD);
+    QUERY_RUN("BEGIN TRANSACTION", return );
+
+    queryBulkItem = QSqlQuery(db);
+    queryBulkItem.prepare(QMSDB_INSERT_ITEM);
+    queryBulkArea = QSqlQuery(db);
+    queryBulkArea.prepare(QMSDB_INSERT_AREA);
+
+    bulk    = true;
+    cntBulk = 0;
 }
 
-quint64 CQmsDb::store(IGisItem& item)
+void CQmsDb::endBulk()
 {
-    // serialize complete history of item
-    QByteArray data;
-    QDataStream in(&data, QIODevice::WriteOnly);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_5_2);
-    in << item.getHistory();
+    if(!bulk)
+    {
+        return;
+    }
 
-    QBuffer buffer;
-    buffer.open(QIODevice::ReadWrite);
-    QPixmap pixmap = item.getDisplayIcon();
-    pixmap.save(&buffer, "PNG");
-    buffer.seek(0);
+    queryBulkItem.finish();
+    queryBulkArea.finish();
 
     QSqlQuery query(db);
+    QUERY_RUN("COMMIT TRANSACTION", NO_CMD);
+    QUERY_RUN("PRAGMA synchronous=" + synchronous, NO_CMD);
+
+    bulk = false;
+}
+
+quint64 CQmsDb::store(QSqlQuery& queryItem, QSqlQuery& queryArea, const item_t& item)
+{
+    QSqlQuery& query = queryItem;
     // item is unknown to database -> create item in database
-    query.prepare("INSERT INTO items (type, keyqms, icon, name, date, comment, data, hash) VALUES (:type, :keyqms, :icon, :name, :date, :comment, :data, :hash)");
-    query.bindValue(":type",    item.type());
-    query.bindValue(":keyqms",     item.getKey().item);
-    query.bindValue(":icon",    buffer.data());
-    query.bindValue(":name",    item.getName());
-    query.bindValue(":date",    item.getTimestamp());
-    query.bindValue(":comment", item.getInfo(IGisItem::eFeatureShowName | IGisItem::eFeatureShowFullText));
-    query.bindValue(":data", data);
-    query.bindValue(":hash", item.getHash());
+    query.bindValue(":type",    item.type);
+    query.bindValue(":keyqms",  item.keyqms);
+    query.bindValue(":icon",    item.icon);
+    query.bindValue(":name",    item.name);
+    query.bindValue(":date",    item.date);
+    query.bindValue(":comment", item.comment);
+    query.bindValue(":data",    item.data);
+    query.bindValue(":hash",    item.hash);
     QUERY_EXEC(return 0);
 
-    query.prepare("SELECT last_insert_rowid() from items");
-    QUERY_EXEC(return 0);
-    query.next();
-    quint64 idItem = query.value(0).toULongLong();
+    quint64 idItem = query.lastInsertId().toULongLong();
+
+    // same as IDB::updateItemArea() but with a statement prepared once
+    if((idItem != 0) && (item.area != QRectF()))
+    {
+        const QRectF& rect = item.area.normalized();
+        queryArea.bindValue(":id",    idItem);
+        queryArea.bindValue(":west",  rect.left()   * RAD_TO_DEG);
+        queryArea.bindValue(":east",  rect.right()  * RAD_TO_DEG);
+        queryArea.bindValue(":south", rect.top()    * RAD_TO_DEG);
+        queryArea.bindValue(":north", rect.bottom() * RAD_TO_DEG);
+        if(!queryArea.exec())
+        {
+            qWarning() << queryArea.lastQuery();
+            qWarning() << queryArea.lastError();
+        }
+    }
 
     return idItem;
 }
@@ -20,33 +20,66 @@
 #define CQMSDB_H
 
 #include "gis/db/IDBSqlite.h"
+#include <QDateTime>
 #include <QMap>
 #include <QObject>
+#include <QRectF>
+#include <QSqlQuery>
 
 class CImportDatabase;
 class IGisItem;
 class CQlgtFolder;
-class CQlgtWpt;
-class CQlgtTrack;
-class CQlgtRoute;
-class IQlgtOverlay;
 
 class CQmsDb : public QObject, private IDBSqlite
 {
     Q_DECLARE_TR_FUNCTIONS(CQmsDb)
 public:
+    /// a converted item, ready to be written to the database
+    struct item_t
+    {
+        /// the item's ID in the QLGT database
+        quint64 idQlgt = 0;
+        qint32 type = 0;
+        QString keyqms;
+        QByteArray icon;
+        QString name;
+        QDateTime date;
+        QString comment;
+        QByteArray data;
+        QString hash;
+        /// the bounding box [rad]
+        QRectF area;
+    };
+
     CQmsDb(const QString& filename, CImportDatabase * parent);
     virtual ~CQmsDb();
 
+    /**
+       @brief Serialize a QMS item into a database record
+
+       The item's icon is rendered into a QPixmap. Therefore this has to be
+       called by the GUI thread.
+
+       @param item      the item to serialize
+       @param record    the record to fill
+     */
+    static void serialize(IGisItem& item, item_t& record);
+
     void addFolder2FolderRelation(quint64 parent, quint64 child);
     void addFolder2ItemRelation(quint64 parent, quint64 child);
 
     void addFolder(CQlgtFolder &folder);
-    void addWpt(CQlgtWpt &wpt1);
-    void addTrk(CQlgtTrack &trk1);
-    void addTrk(IQlgtOverlay &trk1);
-    void addRte(CQlgtRoute& rte1);
-    void addArea(IQlgtOverlay& ovl1);
+    void addItem(const item_t& item);
+
+    /**
+       @brief Start a bulk insert of items
+
+       Until endBulk() is called all items added by addItem() are inserted by
+       reused prepared statements. The transaction is committed every
+       QMSDB_BULK_SIZE items.
+     */
+    void beginBulk();
+    void endBulk();
 
     bool isValid()
     {
@@ -55,10 +88,18 @@ public:
 private:
     bool valid;
 
-    quint64 store(IGisItem &item);
+    quint64 store(QSqlQuery& queryItem, QSqlQuery& queryArea, const item_t& item);
 
     CImportDatabase * gui;
 
+    bool bulk = false;
+    /// number of items inserted by the current bulk transaction
+    quint32 cntBulk = 0;
+    /// synchronous mode of the database before the bulk insert
+    QString synchronous;
+    QSqlQuery queryBulkItem;
+    QSqlQuery queryBulkArea;
+
     QMap<int, int> mapFolderTypes;
 
     QMap<quint64, quint64> mapFolderIDs;
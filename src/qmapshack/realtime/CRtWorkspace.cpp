@@ -16,6 +16,7 @@
 
 **********************************************************************************************/
 
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CSettings.h"
 #include "realtime/CRtDraw.h"
 #include "realtime/CRtSelectSource.h"
@@ -96,7 +97,7 @@ CRtWorkspace::~CRtWorkspace()
 void CRtWorkspace::draw(QPainter& p, const QPolygonF &viewport, CRtDraw *rt) const
 {
     QMutexLocker lock(&IRtSource::mutex);
-    QList<QRectF> blockedAreas;
+    CBlockedAreas blockedAreas;
 
     const int N = treeWidget->topLevelItemCount();
     for(int n = 0; n < N; n++)
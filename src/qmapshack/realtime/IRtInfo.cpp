@@ -87,7 +87,7 @@ void IRtInfo::slotToTrack()
 }
 
 
-void IRtInfo::draw(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt)
+void IRtInfo::draw(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt)
 {
     if(record != nullptr)
     {
@@ -34,7 +34,7 @@ public:
     IRtInfo(IRtSource* source, QWidget * parent);
     virtual ~IRtInfo() = default;
 
-    virtual void draw(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt);
+    virtual void draw(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt);
 
 protected slots:
     void slotSetFilename();
@@ -122,7 +122,7 @@ void IRtRecord::reset()
     QFile::resize(filename, 0);
 }
 
-void IRtRecord::draw(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt)
+void IRtRecord::draw(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt)
 {
     QPolygonF tmp;
     for(const CTrackData::trkpt_t& trkpt : track)
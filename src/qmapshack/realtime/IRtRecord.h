@@ -25,6 +25,7 @@
 #include <QFile>
 #include <QObject>
 
+class CBlockedAreas;
 class CRtDraw;
 class QPainter;
 
@@ -65,7 +66,7 @@ public:
        @param blockedAreas  a list of blocked areas
        @param rt            the draw context
      */
-    virtual void draw(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt);
+    virtual void draw(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt);
 
     virtual const QVector<CTrackData::trkpt_t>& getTrack() const
     {
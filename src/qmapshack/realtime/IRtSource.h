@@ -25,6 +25,7 @@
 #include <QObject>
 #include <QTreeWidgetItem>
 
+class CBlockedAreas;
 class CRtDraw;
 class QSettings;
 
@@ -79,7 +80,7 @@ public:
      */
     virtual QString getDescription() const = 0;
 
-    virtual void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt) = 0;
+    virtual void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt) = 0;
 
     virtual void fastDraw(QPainter& p, const QRectF& viewport, CRtDraw *rt) = 0;
 
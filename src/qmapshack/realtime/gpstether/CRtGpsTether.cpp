@@ -89,7 +89,7 @@ QString CRtGpsTether::getDescription() const
               );
 }
 
-void CRtGpsTether::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt)
+void CRtGpsTether::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt)
 {
     if(info.isNull())
     {
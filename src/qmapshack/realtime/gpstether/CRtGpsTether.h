@@ -40,7 +40,7 @@ public:
     void loadSettings(QSettings& cfg) override;
     void saveSettings(QSettings& cfg) const override;
 
-    void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt) override;
+    void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt) override;
 
     void fastDraw(QPainter& p, const QRectF& viewport, CRtDraw *rt) override;
 
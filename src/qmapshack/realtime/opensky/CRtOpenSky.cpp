@@ -18,6 +18,7 @@
 
 #include "canvas/CCanvas.h"
 #include "CMainWindow.h"
+#include "helpers/CBlockedAreas.h"
 #include "helpers/CDraw.h"
 #include "realtime/CRtDraw.h"
 #include "realtime/opensky/CRtOpenSky.h"
@@ -129,7 +130,7 @@ CRtOpenSky::aircraft_t CRtOpenSky::getAircraftByKey(const QString& key, bool& ok
     return aircraft_t();
 }
 
-void CRtOpenSky::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt)
+void CRtOpenSky::drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt)
 {
     if(checkState(eColumnCheckBox) != Qt::Checked)
     {
@@ -94,7 +94,7 @@ public:
 
     aircraft_t getAircraftByKey(const QString& key, bool& ok) const;
 
-    void drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw * rt) override;
+    void drawItem(QPainter& p, const QPolygonF& viewport, CBlockedAreas& blockedAreas, CRtDraw * rt) override;
     void fastDraw(QPainter& p, const QRectF& viewport, CRtDraw *rt)  override;
     void mouseMove(const QPointF& pos) override;
     static const QString strIcon;
@@ -22,6 +22,8 @@
  * including the positional arguments.
  */
 
+#include <QRectF>
+#include <QSize>
 #include <QStringList>
 
 class CAppOpts
@@ -33,6 +35,13 @@ public:
     const QString configfile;
     const QStringList arguments;
 
+    QString renderFile;          // --render, render an image without GUI and quit
+    QString renderView;          // --view, the view used to render
+    QRectF renderArea;           // --bbox, the area to render in [°]
+    QSize renderSize;            // --size, fit the area into the size in [px]
+    QString benchScenario;       // --bench, run a render benchmark and quit
+    QString batchConfigfile;     // copy of the settings used by --render and --bench
+
     CAppOpts(bool doDebug, bool doLogfile, bool noSplash, const QString& config, const QStringList& args)
         : debug(doDebug)
         , logfile(doLogfile)
@@ -41,6 +50,12 @@ public:
         , arguments(args)
     {
     }
+
+    /// --render and --bench run without GUI and must not change the user's setup or workspace
+    bool isBatch() const
+    {
+        return !renderFile.isEmpty() || !benchScenario.isEmpty();
+    }
 };
 
 extern CAppOpts *qlOpts;
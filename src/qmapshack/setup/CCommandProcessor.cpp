@@ -40,6 +40,21 @@ CAppOpts* CCommandProcessor::processOptions(const QStringList &arguments)
     QCommandLineOption configOption(QStringList() << "c" << "config", tr("File with QMapShack configuration."), tr("file"));
     parser.addOption(configOption);
 
+    QCommandLineOption renderOption("render", tr("Render an image (*.png, *.tif) without GUI and quit. All files passed are loaded as overlays."), tr("file"));
+    parser.addOption(renderOption);
+
+    QCommandLineOption viewOption("view", tr("View (*.view) with maps, DEM, projection and scale used to render."), tr("file"));
+    parser.addOption(viewOption);
+
+    QCommandLineOption bboxOption("bbox", tr("Area to render in [°]. Default is the extent of all files passed."), tr("lon1,lat1,lon2,lat2"));
+    parser.addOption(bboxOption);
+
+    QCommandLineOption sizeOption("size", tr("Zoom to fit the area into the size in [px]. Default is the scale of the view."), tr("WxH"));
+    parser.addOption(sizeOption);
+
+    QCommandLineOption benchOption("bench", tr("Run the render benchmark defined by the scenario (*.json), print the results as JSON and quit."), tr("file"));
+    parser.addOption(benchOption);
+
     parser.addPositionalArgument("files", tr("Files for future use."));
 
     if (!parser.parse(arguments))
@@ -54,5 +69,57 @@ CAppOpts* CCommandProcessor::processOptions(const QStringList &arguments)
         exit(0);
     }
 
-    return new CAppOpts(parser.isSet(debugOption), parser.isSet(logfileOption), parser.isSet(nosplashOption), parser.value(configOption), parser.positionalArguments());
+    CAppOpts * opts = new CAppOpts(parser.isSet(debugOption), parser.isSet(logfileOption), parser.isSet(nosplashOption), parser.value(configOption), parser.positionalArguments());
+
+    if(parser.isSet(renderOption))
+    {
+        opts->renderFile = parser.value(renderOption);
+        opts->renderView = parser.value(viewOption);
+        if(opts->renderView.isEmpty())
+        {
+            std::cerr << tr("--render needs a view passed by --view").toUtf8().constData() << std::endl;
+            exit(1);
+        }
+
+        if(parser.isSet(bboxOption))
+        {
+            const QStringList& values = parser.value(bboxOption).split(',');
+            bool ok = values.size() == 4;
+            qreal v[4] = {0};
+            for(int i = 0; ok && i < 4; i++)
+            {
+                v[i] = values[i].toDouble(&ok);
+            }
+
+            if(!ok)
+            {
+                std::cerr << tr("Bad value for --bbox: %1").arg(parser.value(bboxOption)).toUtf8().constData() << std::endl;
+                exit(1);
+            }
+            opts->renderArea = QRectF(QPointF(v[0], v[1]), QPointF(v[2], v[3])).normalized();
+        }
+
+        if(parser.isSet(sizeOption))
+        {
+            const QStringList& values = parser.value(sizeOption).toLower().split('x');
+            bool ok1 = false, ok2 = false;
+            if(values.size() == 2)
+            {
+                opts->renderSize = QSize(values[0].toInt(&ok1), values[1].toInt(&ok2));
+            }
+
+            if(!ok1 || !ok2 || opts->renderSize.isEmpty())
+            {
+                std::cerr << tr("Bad value for --size: %1").arg(parser.value(sizeOption)).toUtf8().constData() << std::endl;
+                exit(1);
+            }
+        }
+    }
+
+    if(parser.isSet(benchOption))
+    {
+        opts->benchScenario = parser.value(benchOption);
+    }
+
+    return opts;
 }
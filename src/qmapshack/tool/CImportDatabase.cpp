@@ -33,6 +33,7 @@ CImportDatabase::CImportDatabase(QWidget *parent)
 
     labelSource->setText(cfg.value("ConvertDB/source", "-").toString());
     labelTarget->setText(cfg.value("ConvertDB/target", "-").toString());
+    checkBulk->setChecked(cfg.value("ConvertDB/bulk", true).toBool());
 
     textBrowser->setFont(QFont("Courier", 10));
 
@@ -53,6 +54,7 @@ CImportDatabase::~CImportDatabase()
     SETTINGS;
     cfg.setValue("ConvertDB/source", labelSource->text());
     cfg.setValue("ConvertDB/target", labelTarget->text());
+    cfg.setValue("ConvertDB/bulk", checkBulk->isChecked());
 }
 
 void CImportDatabase::stdOut(const QString& str)
@@ -121,7 +123,7 @@ void CImportDatabase::slotSelectTarget()
 void CImportDatabase::slotStart()
 {
     pushStart->setEnabled(false);
-    dbQlgt->start(labelTarget->text());
+    dbQlgt->start(labelTarget->text(), checkBulk->isChecked());
     pushStart->setEnabled(true);
 }
 
@@ -49,7 +49,7 @@ void CHistoryListWidget::setupHistory(IGisItem& gisItem)
 
     key = gisItem.getKey();
 
-    const IGisItem::history_t& history = gisItem.getHistory();
+    const IGisItem::history_t& history = gisItem.getCompleteHistory();
 
     //for(const IGisItem::history_event_t& event : history.events)
     for(int i = 0; i < history.events.size(); i++)
@@ -48,6 +48,8 @@ CSetupExtTools::CSetupExtTools(QWidget *parent)
     connect(toolResetGdalbuildvrt, &QToolButton::pressed, this, slot2(resetGdalbuildvrtOverride));
     connect(toolResetQmtrgb2pct, &QToolButton::pressed, this, slot2(resetQmtrgb2pctOverride));
     connect(toolResetQmtmap2jnx, &QToolButton::pressed, this, slot2(resetQmtmap2jnxOverride));
+
+    connect(spinParallelJobs, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, [](int n){IAppSetup::self().setMaxParallelJobs(n); });
 }
 
 void CSetupExtTools::setupGui()
@@ -73,6 +75,8 @@ void CSetupExtTools::setupGui()
     toolResetGdalbuildvrt->setEnabled(setup.isGdalbuildvrtOverride());
     toolResetQmtrgb2pct->setEnabled(setup.isQmtrgb2pctOverride());
     toolResetQmtmap2jnx->setEnabled(setup.isQmtmap2jnxOverride());
+
+    spinParallelJobs->setValue(setup.getMaxParallelJobs());
 }
 
 void CSetupExtTools::slotSetPathXOverride(const QString& name, fSetPath setPath)
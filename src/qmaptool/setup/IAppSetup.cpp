@@ -46,6 +46,7 @@ IAppSetup::~IAppSetup()
     cfg.setValue("ExtTools/pathGdalbuildvrtOverride",pathGdalbuildvrtOverride);
     cfg.setValue("ExtTools/pathQmtrgb2pctOverride",pathQmtrgb2pctOverride);
     cfg.setValue("ExtTools/pathQmtmap2jnxOverride",pathQmtmap2jnxOverride);
+    cfg.setValue("ExtTools/maxParallelJobs", maxParallelJobs);
 }
 
 IAppSetup& IAppSetup::createInstance(QObject * parent)
@@ -82,6 +83,7 @@ void IAppSetup::prepareToolPaths()
     pathGdalbuildvrtOverride    = cfg.value("ExtTools/pathGdalbuildvrtOverride", pathGdalbuildvrtOverride).toString();
     pathQmtrgb2pctOverride      = cfg.value("ExtTools/pathQmtrgb2pctOverride", pathQmtrgb2pctOverride).toString();
     pathQmtmap2jnxOverride      = cfg.value("ExtTools/pathQmtmap2jnxOverride", pathQmtmap2jnxOverride).toString();
+    maxParallelJobs             = qMax(1, cfg.value("ExtTools/maxParallelJobs", QThread::idealThreadCount()).toInt());
 }
 
 void IAppSetup::prepareGdal(QString gdalDir, QString projDir)
@@ -175,6 +175,17 @@ public:
     }
 
 
+    /// the max. number of external tools CShell runs in parallel
+    qint32 getMaxParallelJobs() const
+    {
+        return maxParallelJobs;
+    }
+
+    void setMaxParallelJobs(qint32 n)
+    {
+        maxParallelJobs = qMax(1, n);
+    }
+
     virtual QString helpFile() = 0;
 signals:
     void sigSetupChanged();
@@ -207,6 +218,8 @@ protected:
     QString pathGdalbuildvrtOverride;
     QString pathQmtrgb2pctOverride;
     QString pathQmtmap2jnxOverride;
+
+    qint32 maxParallelJobs = 1;
 };
 
 #endif // IAPPSETUP_H
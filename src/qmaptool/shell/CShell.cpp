@@ -17,182 +17,186 @@
 **********************************************************************************************/
 
 #include "CMainWindow.h"
+#include "setup/IAppSetup.h"
 #include "shell/CShell.h"
+#include "shell/CShellJob.h"
 
 #include <QtWidgets>
 
 CShell * CShell::pSelf = nullptr;
 
 CShell::CShell(QWidget *parent)
-    : QTextBrowser(parent)
+    : QTabWidget(parent)
 {
     pSelf = this;
 
-    connect(&cmd, &QProcess::readyReadStandardError,  this, &CShell::slotStderr);
-    connect(&cmd, &QProcess::readyReadStandardOutput, this, &CShell::slotStdout);
+    log = new QTextBrowser(this);
+    addTab(log, tr("Log"));
 
-    connect(&cmd, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this, &CShell::slotFinished);
-    connect(&cmd, static_cast<void (QProcess::*)(QProcess::ProcessError)   >(&QProcess::error),    this, &CShell::slotError);
-}
-
-void CShell::slotError(QProcess::ProcessError error)
-{
-    setTextColor(Qt::red);
-    insertPlainText(QString(tr("Execution of external program `%1` failed: ")).arg(cmd.program()));
-    switch(error)
-    {
-    case QProcess::FailedToStart:
-        insertPlainText(QString(tr("Process cannot be started.\n")));
-        insertPlainText(QString(tr("Make sure the required packages are installed, `%1` exists and is executable.\n")).arg(cmd.program()));
-        break;
-
-    case QProcess::Crashed:
-        insertPlainText(QString(tr("External process crashed.\n")));
-        break;
-
-    default:
-        insertPlainText(QString(tr("An unknown error occurred.\n")));
-        break;
-    }
-}
-
-void CShell::slotStderr()
-{
-    QString str;
-    setTextColor(Qt::red);
-    str = cmd.readAllStandardError();
+    setTabsClosable(true);
+    tabBar()->setTabButton(0, QTabBar::RightSide, nullptr);
+    tabBar()->setTabButton(0, QTabBar::LeftSide, nullptr);
 
-    if(str[0] == '\r')
+    connect(this, &CShell::tabCloseRequested, this, [this](int index)
     {
-#ifdef WIN32
-        if(str.contains("\n"))
+        CShellJob * job = dynamic_cast<CShellJob*>(widget(index));
+        if(job != nullptr && !running.contains(job))
         {
-            insertPlainText("\n");
+            removeTab(index);
+            job->deleteLater();
         }
-        else
-#endif // WIN32
-        {
-            moveCursor( QTextCursor::End, QTextCursor::MoveAnchor );
-            moveCursor( QTextCursor::StartOfLine, QTextCursor::MoveAnchor );
-            moveCursor( QTextCursor::End, QTextCursor::KeepAnchor );
-            textCursor().removeSelectedText();
-        }
-
-
-#ifdef WIN32
-        str = str.split("\r").last().remove("\r").remove("\n");
-#else
-        str = str.split("\r").last();
-#endif
-    }
-
-    insertPlainText(str);
-    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
-}
-
-void CShell::slotStdout()
-{
-    QString str;
-    setTextColor(Qt::blue);
-    str = cmd.readAllStandardOutput();
-
-    if(str[0] == '\r')
-    {
-#ifdef WIN32
-        if(str.contains("\n"))
-        {
-            insertPlainText("\n");
-        }
-        else
-#endif // WIN32
-        {
-            moveCursor( QTextCursor::End, QTextCursor::MoveAnchor );
-            moveCursor( QTextCursor::StartOfLine, QTextCursor::MoveAnchor );
-            moveCursor( QTextCursor::End, QTextCursor::KeepAnchor );
-            textCursor().removeSelectedText();
-        }
-
-#ifdef WIN32
-        str = str.split("\r").last().remove("\r").remove("\n");
-#else
-        str = str.split("\r").last();
-#endif
-    }
-
-    insertPlainText(str);
-    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    });
 }
 
 void CShell::stdOut(const QString& str)
 {
-    setTextColor(Qt::black);
-    append(str);
+    log->setTextColor(Qt::black);
+    log->append(str);
 }
 
 
 void CShell::stdErr(const QString& str)
 {
-    setTextColor(Qt::red);
-    append(str);
+    log->setTextColor(Qt::red);
+    log->append(str);
 }
 
 
-void CShell::slotFinished(int exitCode, QProcess::ExitStatus status)
+void CShell::slotFinished(qint32 idx, bool ok)
 {
-    if(exitCode || status)
+    CShellJob * job = nullptr;
+    for(CShellJob * j : running)
+    {
+        if(j->getIndex() == idx)
+        {
+            job = j;
+            break;
+        }
+    }
+
+    if(job == nullptr)
     {
-        emit sigFinishedJob(jobId);
-        setTextColor(Qt::red);
-        append(tr("!!! failed !!!\n"));
+        // e.g. finished() after error() for processes failing to start
         return;
     }
 
-    ++idxCommand;
+    running.removeOne(job);
+    states[idx] = ok ? eStateDone : eStateFailed;
+
+    if(ok)
+    {
+        // move the output to the log and close the job's tab
+        log->moveCursor(QTextCursor::End);
+        log->insertHtml(job->toHtml());
+        log->append("");
+        log->verticalScrollBar()->setValue(log->verticalScrollBar()->maximum());
+
+        removeTab(indexOf(job));
+        job->deleteLater();
+    }
+    else
+    {
+        aborted = true;
+        stdErr(tr("Failed: %1").arg(job->getCommandLine()));
+        setTabText(indexOf(job), "!" + job->getName());
+        setCurrentWidget(job);
+    }
+
     nextCommand();
 }
 
 void CShell::slotCancel()
 {
-    if(cmd.state() == QProcess::NotRunning)
+    if(running.isEmpty())
     {
         return;
     }
 
+    aborted = true;
     stdOut(tr("\nCanceled by user's request.\n"));
-    cmd.kill();
-    cmd.waitForFinished(10000);
+
+    for(CShellJob * job : running)
+    {
+        job->kill();
+    }
 }
 
 int CShell::execute(QList<CShellCmd> cmds)
 {
     CMainWindow::self().makeShellVisible();
 
-    if(cmd.state() != QProcess::NotRunning)
+    if(!running.isEmpty())
     {
         return -1;
     }
 
-    clear();
+    // remove tabs of previously failed commands
+    while(count() > 1)
+    {
+        QWidget * w = widget(1);
+        removeTab(1);
+        delete w;
+    }
+    log->clear();
 
-    idxCommand  = 0;
     commands    = cmds;
+    states      = QVector<state_e>(cmds.size(), eStatePending);
+    aborted     = false;
 
+    ++jobId;
     nextCommand();
-    return ++jobId;
+    return jobId;
 }
 
+bool CShell::isReady(qint32 idx) const
+{
+    for(qint32 dep : commands[idx].getDependencies(idx))
+    {
+        if(dep >= 0 && dep < states.size() && states[dep] != eStateDone)
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
 void CShell::nextCommand()
 {
-    if(idxCommand >= commands.size())
+    const qint32 maxJobs = qMax(1, IAppSetup::self().getMaxParallelJobs());
+
+    for(qint32 idx = 0; !aborted && idx < commands.size() && running.size() < maxJobs; idx++)
+    {
+        if(states[idx] != eStatePending || !isReady(idx))
+        {
+            continue;
+        }
+
+        CShellJob * job = new CShellJob(commands[idx], idx, this);
+        connect(job, &CShellJob::sigFinished, this, &CShell::slotFinished, Qt::QueuedConnection);
+
+        states[idx] = eStateRunning;
+        running << job;
+        addTab(job, job->getName());
+        stdOut(job->getCommandLine());
+
+        job->start();
+    }
+
+    if(!running.isEmpty())
     {
-        emit sigFinishedJob(jobId);
-        setTextColor(Qt::darkGreen);
-        append(tr("!!! done !!!\n"));
         return;
     }
 
-    const CShellCmd& command = commands[idxCommand];
-    stdOut(command.getCmd() + " " + command.getArgs().join(" ") + "\n");
-    cmd.start(command.getCmd(), command.getArgs());
+    // nothing is running anymore. Either all is done or nothing can be done
+    emit sigFinishedJob(jobId);
+    if(aborted || states.contains(eStateFailed) || states.contains(eStatePending))
+    {
+        log->setTextColor(Qt::red);
+        log->append(tr("!!! failed !!!\n"));
+    }
+    else
+    {
+        log->setTextColor(Qt::darkGreen);
+        log->append(tr("!!! done !!!\n"));
+    }
 }
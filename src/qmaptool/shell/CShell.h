@@ -22,10 +22,22 @@
 #include "shell/CShellCmd.h"
 
 #include <QList>
-#include <QProcess>
-#include <QTextBrowser>
-
-class CShell : public QTextBrowser
+#include <QTabWidget>
+#include <QVector>
+
+class CShellJob;
+class QTextBrowser;
+
+/**
+   @brief Execute a list of commands as a job graph
+
+   Each command depends on the commands given by CShellCmd::getDependencies().
+   All commands with finished dependencies are started in parallel up to the
+   number of parallel jobs configured in IAppSetup. Each running command has
+   it's own tab with it's output. The output of successful commands is moved to
+   the log tab when they finish. Failed commands keep their tab for inspection.
+ */
+class CShell : public QTabWidget
 {
     Q_OBJECT
 public:
@@ -44,25 +56,34 @@ public slots:
     void slotCancel();
 
 protected slots:
-    /// read the stderr from the process and paste it into the text browser
-    void slotStderr();
-    /// read the stdout from the process and paste it into the text browser
-    void slotStdout();
-    void slotError(QProcess::ProcessError error);
-    virtual void slotFinished(int exitCode, QProcess::ExitStatus status);
+    virtual void slotFinished(qint32 idx, bool ok);
 
 protected:
+    /// start all commands with finished dependencies
     void nextCommand();
+    /// true if all dependencies of the command with the given index are done
+    bool isReady(qint32 idx) const;
 
-    /// write text to stdout color channel of the text browser
+    /// write text to stdout color channel of the log
     void stdOut(const QString& str);
-    /// write text to stderr color channel of the text browser
+    /// write text to stderr color channel of the log
     void stdErr(const QString& str);
 
-    QProcess cmd;
+    enum state_e
+    {
+        eStatePending
+        , eStateRunning
+        , eStateDone
+        , eStateFailed
+    };
+
+    QTextBrowser * log;
 
     QList<CShellCmd> commands;
-    qint32 idxCommand = 0;
+    QVector<state_e> states;
+    QList<CShellJob*> running;
+    /// true if a command failed or the user canceled. No further commands are started.
+    bool aborted = false;
     qint32 jobId = 0;
 
 private:
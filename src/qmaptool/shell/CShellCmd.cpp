@@ -24,4 +24,12 @@ CShellCmd::CShellCmd(const QString &cmd, const QStringList &args)
 {
 }
 
+QList<qint32> CShellCmd::getDependencies(qint32 self) const
+{
+    if(hasDependencies)
+    {
+        return dependencies;
+    }
 
+    return self > 0 ? QList<qint32>({self - 1}) : QList<qint32>();
+}
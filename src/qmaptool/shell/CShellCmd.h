@@ -19,6 +19,7 @@
 #ifndef CSHELLCMD_H
 #define CSHELLCMD_H
 
+#include <QList>
 #include <QString>
 #include <QStringList>
 
@@ -38,9 +39,33 @@ public:
         return args;
     }
 
+    /**
+       @brief Set the commands that have to finish before this one can start
+
+       By default a command depends on its predecessor in the list of commands. Setting
+       the dependencies explicitly allows CShell to run independent commands in parallel.
+
+       @param idx   a list of indices into the list of commands passed to CShell::execute()
+     */
+    void setDependencies(const QList<qint32>& idx)
+    {
+        dependencies = idx;
+        hasDependencies = true;
+    }
+
+    /**
+       @brief Get the indices of all commands this command depends on
+
+       @param self  the index of this command in the list of commands
+     */
+    QList<qint32> getDependencies(qint32 self) const;
+
 private:
     QString cmd;
     QStringList args;
+
+    QList<qint32> dependencies;
+    bool hasDependencies = false;
 };
 
 #endif //CSHELLCMD_H
@@ -0,0 +1,130 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "shell/CShellJob.h"
+
+#include <QtWidgets>
+
+CShellJob::CShellJob(const CShellCmd& command, qint32 idx, QWidget *parent)
+    : QTextBrowser(parent)
+    , command(command)
+    , idx(idx)
+{
+    connect(&cmd, &QProcess::readyReadStandardError,  this, &CShellJob::slotStderr);
+    connect(&cmd, &QProcess::readyReadStandardOutput, this, &CShellJob::slotStdout);
+
+    connect(&cmd, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this, &CShellJob::slotFinished);
+    connect(&cmd, static_cast<void (QProcess::*)(QProcess::ProcessError)   >(&QProcess::error),    this, &CShellJob::slotError);
+}
+
+QString CShellJob::getName() const
+{
+    return QString("%1 #%2").arg(QFileInfo(command.getCmd()).completeBaseName()).arg(idx + 1);
+}
+
+QString CShellJob::getCommandLine() const
+{
+    return command.getCmd() + " " + command.getArgs().join(" ");
+}
+
+void CShellJob::start()
+{
+    setTextColor(Qt::black);
+    append(getCommandLine() + "\n");
+    cmd.start(command.getCmd(), command.getArgs());
+}
+
+void CShellJob::kill()
+{
+    if(cmd.state() == QProcess::NotRunning)
+    {
+        return;
+    }
+
+    cmd.kill();
+    cmd.waitForFinished(10000);
+}
+
+void CShellJob::slotError(QProcess::ProcessError error)
+{
+    setTextColor(Qt::red);
+    insertPlainText(QString(tr("Execution of external program `%1` failed: ")).arg(cmd.program()));
+    switch(error)
+    {
+    case QProcess::FailedToStart:
+        insertPlainText(QString(tr("Process cannot be started.\n")));
+        insertPlainText(QString(tr("Make sure the required packages are installed, `%1` exists and is executable.\n")).arg(cmd.program()));
+        // there will be no finished() signal
+        emit sigFinished(idx, false);
+        break;
+
+    case QProcess::Crashed:
+        insertPlainText(QString(tr("External process crashed.\n")));
+        break;
+
+    default:
+        insertPlainText(QString(tr("An unknown error occurred.\n")));
+        break;
+    }
+}
+
+void CShellJob::insertProcessText(const QColor& color, QString str)
+{
+    setTextColor(color);
+
+    if(str[0] == '\r')
+    {
+#ifdef WIN32
+        if(str.contains("\n"))
+        {
+            insertPlainText("\n");
+        }
+        else
+#endif // WIN32
+        {
+            moveCursor( QTextCursor::End, QTextCursor::MoveAnchor );
+            moveCursor( QTextCursor::StartOfLine, QTextCursor::MoveAnchor );
+            moveCursor( QTextCursor::End, QTextCursor::KeepAnchor );
+            textCursor().removeSelectedText();
+        }
+
+#ifdef WIN32
+        str = str.split("\r").last().remove("\r").remove("\n");
+#else
+        str = str.split("\r").last();
+#endif
+    }
+
+    insertPlainText(str);
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+void CShellJob::slotStderr()
+{
+    insertProcessText(Qt::red, cmd.readAllStandardError());
+}
+
+void CShellJob::slotStdout()
+{
+    insertProcessText(Qt::blue, cmd.readAllStandardOutput());
+}
+
+void CShellJob::slotFinished(int exitCode, QProcess::ExitStatus status)
+{
+    emit sigFinished(idx, !(exitCode || status));
+}
@@ -0,0 +1,83 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CSHELLJOB_H
+#define CSHELLJOB_H
+
+#include "shell/CShellCmd.h"
+
+#include <QProcess>
+#include <QTextBrowser>
+
+/**
+   @brief A single command executed by CShell
+
+   The job runs the command in its own process and collects the output in
+   its own text browser. CShell shows the job as a tab as long as it is running.
+ */
+class CShellJob : public QTextBrowser
+{
+    Q_OBJECT
+public:
+    CShellJob(const CShellCmd& command, qint32 idx, QWidget * parent);
+    virtual ~CShellJob() = default;
+
+    /// start the process
+    void start();
+    /// kill the process and wait for it to terminate
+    void kill();
+
+    qint32 getIndex() const
+    {
+        return idx;
+    }
+
+    /// a short name for the tab
+    QString getName() const;
+
+    /// the command line as string
+    QString getCommandLine() const;
+
+signals:
+    /**
+       @brief Emitted when the process has terminated
+
+       @param idx   the index of the command
+       @param ok    true if the command was successful
+     */
+    void sigFinished(qint32 idx, bool ok);
+
+private slots:
+    /// read the stderr from the process and paste it into the text browser
+    void slotStderr();
+    /// read the stdout from the process and paste it into the text browser
+    void slotStdout();
+    void slotError(QProcess::ProcessError error);
+    void slotFinished(int exitCode, QProcess::ExitStatus status);
+
+private:
+    void insertProcessText(const QColor& color, QString str);
+
+    CShellCmd command;
+    qint32 idx;
+
+    QProcess cmd;
+};
+
+#endif //CSHELLJOB_H
+
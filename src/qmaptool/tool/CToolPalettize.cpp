@@ -188,9 +188,14 @@ void CToolPalettize::buildCmdFinal(QList<CShellCmd>& cmds)
     args << vrtFilename;
     cmds << CShellCmd(IAppSetup::self().getQmtrgb2pct(), args);
 
+    // the color table is needed by all following commands of all files
+    const qint32 idxPct = cmds.size() - 1;
+
     // ---- command 2..2 + N ----------------------
     if(radioCombined->isChecked())
     {
+        QList<qint32> idxFiles;
+
         inputFileList2->open();
         QTextStream stream(inputFileList2);
 
@@ -212,6 +217,8 @@ void CToolPalettize::buildCmdFinal(QList<CShellCmd>& cmds)
             args << inFilename;
             args << outFilename;
             cmds << CShellCmd(IAppSetup::self().getQmtrgb2pct(), args);
+            cmds.last().setDependencies({idxPct});
+            idxFiles << cmds.size() - 1;
         }
 
         inputFileList2->close();
@@ -222,6 +229,7 @@ void CToolPalettize::buildCmdFinal(QList<CShellCmd>& cmds)
         args << vrtFilename;
         args << "-input_file_list" << inputFileList2->fileName();
         cmds << CShellCmd(IAppSetup::self().getGdalbuildvrt(), args);
+        cmds.last().setDependencies(idxFiles);
 
         // ---- command 2 + N + 2 ----------------------
         QString outFilename = lineFilename->text();        
@@ -273,6 +281,8 @@ void CToolPalettize::buildCmdFinal(QList<CShellCmd>& cmds)
             args << inFilename;
             args << outFilename;
             cmds << CShellCmd(IAppSetup::self().getQmtrgb2pct(), args);
+            // the files are processed in parallel
+            cmds.last().setDependencies({idxPct});
 
             QString lastOutFilname = outFilename;
             // ---- command n*3 + 1 ----------------------
@@ -52,6 +52,31 @@ bool IToolGui::finished(qint32 id)
 }
 
 
+void IToolGui::finishChain(QList<CShellCmd>& cmds)
+{
+    if(cmds.size() == idxChainStart)
+    {
+        return;
+    }
+
+    // the commands of a single item do not depend on the commands of other items
+    cmds[idxChainStart].setDependencies({});
+    idxChainEnds << cmds.size() - 1;
+    idxChainStart = cmds.size();
+}
+
+void IToolGui::finishFinalCmds(QList<CShellCmd>& cmds)
+{
+    // the final commands depend on all commands of all items
+    if(cmds.size() > idxChainStart)
+    {
+        cmds[idxChainStart].setDependencies(idxChainEnds);
+    }
+
+    idxChainStart = 0;
+    idxChainEnds.clear();
+}
+
 void IToolGui::start(CItemTreeWidget * itemTree)
 {
     QList<CShellCmd> cmds;
@@ -70,11 +95,13 @@ void IToolGui::start(CItemTreeWidget * itemTree)
             if(nullptr != item)
             {
                 buildCmd(cmds, item);
+                finishChain(cmds);
             }
         }
     }
 
     buildCmdFinal(cmds);
+    finishFinalCmds(cmds);
 
     jobId = CShell::self().execute(cmds);
 }
@@ -92,6 +119,7 @@ void IToolGui::start(CItemListWidget * itemList, bool allFiles)
             if(nullptr != item)
             {
                 buildCmd(cmds, item);
+                finishChain(cmds);
             }
         }
     }
@@ -101,10 +129,12 @@ void IToolGui::start(CItemListWidget * itemList, bool allFiles)
         if(nullptr != item)
         {
             buildCmd(cmds, item);
+            finishChain(cmds);
         }
     }
 
     buildCmdFinal(cmds);
+    finishFinalCmds(cmds);
 
     jobId = CShell::self().execute(cmds);
 }
@@ -42,6 +42,19 @@ protected:
     QString createTempFile(const QString &ext);
     qint32 jobId = 0;
     QList<QTemporaryFile*> tmpFiles;
+
+private:
+    /**
+       @brief Mark the commands added by the last call of buildCmd() as independent chain
+
+       Chains of different items can be executed in parallel by CShell.
+     */
+    void finishChain(QList<CShellCmd>& cmds);
+    /// let the commands added by buildCmdFinal() wait for all chains
+    void finishFinalCmds(QList<CShellCmd>& cmds);
+
+    qint32 idxChainStart = 0;
+    QList<qint32> idxChainEnds;
 };
 
 #endif //ITOOLGUI_H
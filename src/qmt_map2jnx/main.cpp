@@ -30,8 +30,13 @@
 #include <wctype.h>
 
 
+#include <atomic>
+#include <condition_variable>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gdal_priv.h>
@@ -173,14 +178,81 @@ static projPJ wgs84;
 static jnx_hdr_t jnx_hdr;
 /// the tile information table for all 5 levels
 static jnx_tile_t tileTable[JNX_MAX_TILES * 5];
-/// tile buffer for 8 bit palette tiles, private to readTile
-static uint8_t  tileBuf8Bit[JNX_MAX_TILE_SIZE * JNX_MAX_TILE_SIZE] = {0};
-/// tile buffer for 24 bit raw RGB tiles, private to writeTile
-static uint8_t tileBuf24Bit[JNX_MAX_TILE_SIZE * JNX_MAX_TILE_SIZE * 3] = {0};
-/// tile buffer for 32 bit raw RGBA tiles
-static uint32_t tileBuf32Bit[JNX_MAX_TILE_SIZE * JNX_MAX_TILE_SIZE] = {0};
-/// internal jpeg buffer used by write tile.
-static std::vector<JOCTET> jpgbuf;
+
+/// a single tile to be converted
+struct job_t
+{
+    file_t * file;
+    uint32_t xoff;
+    uint32_t yoff;
+    uint32_t xsize;
+    uint32_t ysize;
+};
+
+/// the result of a converted tile, handed from the workers to the writer
+struct result_t
+{
+    result_t() : done(false), ok(false){}
+    bool done;
+    bool ok;
+    /// the JPEG coded tile
+    std::vector<JOCTET> jpg;
+};
+
+/// private data of a worker thread
+struct worker_t
+{
+    worker_t()
+        : tileBuf8Bit(JNX_MAX_TILE_SIZE * JNX_MAX_TILE_SIZE)
+        , tileBuf24Bit(JNX_MAX_TILE_SIZE * JNX_MAX_TILE_SIZE * 3)
+        , tileBuf32Bit(JNX_MAX_TILE_SIZE * JNX_MAX_TILE_SIZE)
+    {
+    }
+
+    ~worker_t()
+    {
+        for(std::map<file_t*, GDALDataset*>::iterator h = datasets.begin(); h != datasets.end(); h++)
+        {
+            GDALClose(h->second);
+        }
+    }
+
+    /// GDAL handles are not thread safe. Each worker opens the files by itself
+    std::map<file_t*, GDALDataset*> datasets;
+    /// tile buffer for 8 bit palette tiles, private to readTile
+    std::vector<uint8_t>  tileBuf8Bit;
+    /// tile buffer for 24 bit raw RGB tiles, private to encodeTile
+    std::vector<uint8_t>  tileBuf24Bit;
+    /// tile buffer for 32 bit raw RGBA tiles
+    std::vector<uint32_t> tileBuf32Bit;
+};
+
+/// the pipeline shared by the worker threads and the writer
+struct pipeline_t
+{
+    pipeline_t() : nextJob(0), nextWrite(0), window(0), abort(false), quality(-1), subsampling(-1){}
+
+    std::vector<job_t>    jobs;
+    std::vector<result_t> results;
+
+    /// index of the next job to be picked by a worker
+    std::atomic<uint32_t> nextJob;
+    /// index of the next tile to be written, protected by mutex
+    uint32_t nextWrite;
+    /// max. number of tiles converted ahead of the writer
+    uint32_t window;
+    /// set by the writer on errors to stop all workers
+    bool abort;
+
+    std::mutex mutex;
+    /// signaled by the workers on a finished tile
+    std::condition_variable tileDone;
+    /// signaled by the writer on a written tile
+    std::condition_variable tileWritten;
+
+    int quality;
+    int subsampling;
+};
 
 static void prinfFileinfo(const file_t& file)
 {
@@ -202,9 +274,8 @@ static void prinfFileinfo(const file_t& file)
     printf("\nreal scale: %f m/px", file.scale);
 }
 
-bool readTile(uint32_t xoff, uint32_t yoff, uint32_t xsize, uint32_t ysize, file_t& file, uint32_t * output)
+bool readTile(uint32_t xoff, uint32_t yoff, uint32_t xsize, uint32_t ysize, file_t& file, GDALDataset * dataset, uint8_t * tileBuf8Bit, uint32_t * output)
 {
-    GDALDataset * dataset = file.dataset;
     int32_t rasterBandCount = dataset->GetRasterCount();
 
     memset(output,-1, sizeof(uint32_t) * xsize * ysize);
@@ -255,6 +326,7 @@ bool readTile(uint32_t xoff, uint32_t yoff, uint32_t xsize, uint32_t ysize, file
 
 static void init_destination (j_compress_ptr cinfo)
 {
+    std::vector<JOCTET>& jpgbuf = *(std::vector<JOCTET>*)cinfo->client_data;
     jpgbuf.resize(JPG_BLOCK_SIZE);
     cinfo->dest->next_output_byte   = &jpgbuf[0];
     cinfo->dest->free_in_buffer     = jpgbuf.size();
@@ -262,6 +334,7 @@ static void init_destination (j_compress_ptr cinfo)
 
 static boolean empty_output_buffer (j_compress_ptr cinfo)
 {
+    std::vector<JOCTET>& jpgbuf = *(std::vector<JOCTET>*)cinfo->client_data;
     size_t oldsize = jpgbuf.size();
     jpgbuf.resize(oldsize + JPG_BLOCK_SIZE);
     cinfo->dest->next_output_byte   = &jpgbuf[oldsize];
@@ -271,13 +344,14 @@ static boolean empty_output_buffer (j_compress_ptr cinfo)
 
 static void term_destination (j_compress_ptr cinfo)
 {
+    std::vector<JOCTET>& jpgbuf = *(std::vector<JOCTET>*)cinfo->client_data;
     jpgbuf.resize(jpgbuf.size() - cinfo->dest->free_in_buffer);
 }
 
 
-static uint32_t writeTile(uint32_t xsize, uint32_t ysize, uint32_t * raw_image, FILE * fid, int quality, int subsampling)
+/// JPEG encode a raw RGBA tile into jpgbuf
+static void encodeTile(uint32_t xsize, uint32_t ysize, uint32_t * raw_image, uint8_t * tileBuf24Bit, std::vector<JOCTET>& jpgbuf, int quality, int subsampling)
 {
-    uint32_t size = 0;
     struct jpeg_compress_struct cinfo;
     struct jpeg_error_mgr jerr;
     JSAMPROW row_pointer[1];
@@ -302,6 +376,7 @@ static uint32_t writeTile(uint32_t xsize, uint32_t ysize, uint32_t * raw_image,
     cinfo.err = jpeg_std_error( &jerr );
     jpeg_create_compress(&cinfo);
 
+    cinfo.client_data       = &jpgbuf;
     cinfo.dest              = &destmgr;
     cinfo.image_width       = xsize;
     cinfo.image_height      = ysize;
@@ -362,12 +437,63 @@ static uint32_t writeTile(uint32_t xsize, uint32_t ysize, uint32_t * raw_image,
     /* similar to read file, clean up after we're done compressing */
     jpeg_finish_compress( &cinfo );
     jpeg_destroy_compress( &cinfo );
+}
+
+static GDALDataset * getDataset(worker_t& worker, file_t& file)
+{
+    GDALDataset *& dataset = worker.datasets[&file];
+    if(dataset == 0)
+    {
+        dataset = (GDALDataset*)GDALOpen(file.filename.c_str(), GA_ReadOnly);
+    }
+    return dataset;
+}
+
+/**
+   @brief Read and encode tiles until all jobs are done
+
+   The workers pick the jobs in order. They never run more than
+   pipeline.window tiles ahead of the writer to limit the memory
+   used by pending results.
+ */
+static void runWorker(pipeline_t& pipeline)
+{
+    worker_t worker;
 
-    // write data to output file
-    size = jpgbuf.size() - 2;
-    fwrite(&jpgbuf[2], size, 1, fid);
+    while(true)
+    {
+        uint32_t idx = pipeline.nextJob++;
+        if(idx >= pipeline.jobs.size())
+        {
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(pipeline.mutex);
+            pipeline.tileWritten.wait(lock, [&]{ return pipeline.abort || (idx < pipeline.nextWrite + pipeline.window); });
+            if(pipeline.abort)
+            {
+                break;
+            }
+        }
 
-    return size;
+        const job_t& job = pipeline.jobs[idx];
+        std::vector<JOCTET> jpg;
+
+        GDALDataset * dataset = getDataset(worker, *job.file);
+        bool ok = (dataset != 0) && readTile(job.xoff, job.yoff, job.xsize, job.ysize, *job.file, dataset, worker.tileBuf8Bit.data(), worker.tileBuf32Bit.data());
+        if(ok)
+        {
+            encodeTile(job.xsize, job.ysize, worker.tileBuf32Bit.data(), worker.tileBuf24Bit.data(), jpg, pipeline.quality, pipeline.subsampling);
+        }
+
+        std::lock_guard<std::mutex> lock(pipeline.mutex);
+        result_t& result = pipeline.results[idx];
+        result.jpg.swap(jpg);
+        result.ok   = ok;
+        result.done = true;
+        pipeline.tileDone.notify_all();
+    }
 }
 
 static double distance(const double u1, const double v1, const double u2, const double v2)
@@ -532,6 +658,7 @@ int main(int argc, char ** argv)
     OGRSpatialReference oSRS;
     int quality         = -1;
     int subsampling     = -1;
+    int threads         = (int)std::thread::hardware_concurrency();
 
     const char *copyright = "Unknown";
     const char *subscname = "BirdsEye";
@@ -547,10 +674,11 @@ int main(int argc, char ** argv)
 
     if(argc < 2)
     {
-        fprintf(stderr,"\nusage: qmt_map2jnx -q <1..100> -s <411|422|444> -p <0..> -c \"copyright notice\" -m \"BirdsEye\" -n \"Unknown\" -x file1_scale,file2_scale,...,fileN_scale <file1> <file2> ... <fileN> <outputfile>\n");
+        fprintf(stderr,"\nusage: qmt_map2jnx -q <1..100> -s <411|422|444> -j <1..> -p <0..> -c \"copyright notice\" -m \"BirdsEye\" -n \"Unknown\" -x file1_scale,file2_scale,...,fileN_scale <file1> <file2> ... <fileN> <outputfile>\n");
         fprintf(stderr,"\n");
         fprintf(stderr,"  -q The JPEG quality from 1 to 100. Default is 75 \n");
         fprintf(stderr,"  -s The chroma subsampling. Default is 411  \n");
+        fprintf(stderr,"  -j The number of threads to read and encode tiles. Default is the number of CPU cores  \n");
         fprintf(stderr,"  -p The product ID. Default is 0  \n");
         fprintf(stderr,"  -c The copyright notice. Default is \"Unknown\"  \n");
         fprintf(stderr,"  -m The subscription product name. Default is \"BirdsEye\"  \n");
@@ -618,6 +746,12 @@ int main(int argc, char ** argv)
                 skip_next_arg = 1;
                 continue;
             }
+            else if (towupper(argv[i][1]) == 'J')
+            {
+                threads = atol(argv[i+1]);
+                skip_next_arg = 1;
+                continue;
+            }
             else if (towupper(argv[i][1]) == 'P')
             {
                 jnx_hdr.productId = atol(argv[i+1]);
@@ -930,8 +1064,11 @@ int main(int argc, char ** argv)
     fwrite(tileTable, sizeof(jnx_tile_t), tilesTotal, fid);
 
     // --------------------------------------------------------------
-    // read tiles from input files and write jpeg coded tiles to output file
-    printf("\n\nStart conversion:\n");
+    // collect all tiles in the order they are written to the output file
+    pipeline_t pipeline;
+    pipeline.quality        = quality;
+    pipeline.subsampling    = subsampling;
+
     for(int l = 0; l < nLevels; l++)
     {
         level_t& level = levels[l];
@@ -964,58 +1101,122 @@ int main(int argc, char ** argv)
                         xsize = (file.width - xoff);
                     }
 
-                    // //
-                    if(!readTile(xoff, yoff, xsize, ysize, file, tileBuf32Bit))
-                    {
-                        fprintf(stderr,"\nError reading tiles from map file\n");
-                        exit(-1);
-                    }
+                    job_t job;
+                    job.file    = &file;
+                    job.xoff    = xoff;
+                    job.yoff    = yoff;
+                    job.xsize   = xsize;
+                    job.ysize   = ysize;
+                    pipeline.jobs.push_back(job);
 
-                    jnx_tile_t& tile = tileTable[tileCnt++];
-                    if(pj_is_latlong(file.pj))
-                    {
+                    xoff += xsize;
+                }
 
-                        double u1 = file.lon1 + xoff * file.xscale;
-                        double v1 = file.lat1 + yoff * file.yscale;
-                        double u2 = file.lon1 + (xoff + xsize) * file.xscale;
-                        double v2 = file.lat1 + (yoff + ysize) * file.yscale;
+                yoff += ysize;
+            }
+        }
+    }
 
+    // --------------------------------------------------------------
+    // read and encode tiles in worker threads and write jpeg coded tiles to output file
+    if(threads < 1)
+    {
+        threads = 1;
+    }
+    pipeline.window = 4 * threads;
+    pipeline.results.resize(pipeline.jobs.size());
 
-                        tile.left   = (int32_t)(u1 * 0x7FFFFFFF / 180);
-                        tile.top    = (int32_t)(v1 * 0x7FFFFFFF / 180);
-                        tile.right  = (int32_t)(u2 * 0x7FFFFFFF / 180);
-                        tile.bottom = (int32_t)(v2 * 0x7FFFFFFF / 180);
+    printf("\n\nStart conversion (%i threads):\n", threads);
 
-                    }
-                    else
-                    {
-                        double u1 = file.xref1 + xoff * file.xscale;
-                        double v1 = file.yref1 + yoff * file.yscale;
-                        double u2 = file.xref1 + (xoff + xsize) * file.xscale;
-                        double v2 = file.yref1 + (yoff + ysize) * file.yscale;
-
-                        pj_transform(file.pj,wgs84,1,0,&u1,&v1,0);
-                        pj_transform(file.pj,wgs84,1,0,&u2,&v2,0);
-
-                        tile.left    = (int32_t)((u1 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
-                        tile.top     = (int32_t)((v1 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
-                        tile.right   = (int32_t)((u2 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
-                        tile.bottom  = (int32_t)((v2 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
-                    }
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++)
+    {
+        workers.push_back(std::thread(runWorker, std::ref(pipeline)));
+    }
 
-                    tile.width  = xsize;
-                    tile.height = ysize;
-                    tile.offset = (uint32_t)(ftello(fid) & 0x0FFFFFFFF);
-                    tile.size   = writeTile(xsize, ysize, tileBuf32Bit, fid, quality, subsampling);
+    bool ok = true;
+    for(tileCnt = 0; tileCnt < pipeline.jobs.size(); tileCnt++)
+    {
+        std::vector<JOCTET> jpg;
+        {
+            std::unique_lock<std::mutex> lock(pipeline.mutex);
+            result_t& result = pipeline.results[tileCnt];
+            pipeline.tileDone.wait(lock, [&]{ return result.done; });
+            ok = result.ok;
+            jpg.swap(result.jpg);
+        }
 
-                    printProgress(tileCnt, tilesTotal);
-                    // //
-                    xoff += xsize;
-                }
+        if(!ok)
+        {
+            break;
+        }
 
-                yoff += ysize;
-            }
+        const job_t& job = pipeline.jobs[tileCnt];
+        const file_t& file = *job.file;
+
+        jnx_tile_t& tile = tileTable[tileCnt];
+        if(pj_is_latlong(file.pj))
+        {
+
+            double u1 = file.lon1 + job.xoff * file.xscale;
+            double v1 = file.lat1 + job.yoff * file.yscale;
+            double u2 = file.lon1 + (job.xoff + job.xsize) * file.xscale;
+            double v2 = file.lat1 + (job.yoff + job.ysize) * file.yscale;
+
+
+            tile.left   = (int32_t)(u1 * 0x7FFFFFFF / 180);
+            tile.top    = (int32_t)(v1 * 0x7FFFFFFF / 180);
+            tile.right  = (int32_t)(u2 * 0x7FFFFFFF / 180);
+            tile.bottom = (int32_t)(v2 * 0x7FFFFFFF / 180);
+
+        }
+        else
+        {
+            double u1 = file.xref1 + job.xoff * file.xscale;
+            double v1 = file.yref1 + job.yoff * file.yscale;
+            double u2 = file.xref1 + (job.xoff + job.xsize) * file.xscale;
+            double v2 = file.yref1 + (job.yoff + job.ysize) * file.yscale;
+
+            pj_transform(file.pj,wgs84,1,0,&u1,&v1,0);
+            pj_transform(file.pj,wgs84,1,0,&u2,&v2,0);
+
+            tile.left    = (int32_t)((u1 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
+            tile.top     = (int32_t)((v1 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
+            tile.right   = (int32_t)((u2 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
+            tile.bottom  = (int32_t)((v2 * RAD_TO_DEG) * 0x7FFFFFFF / 180);
+        }
+
+        tile.width  = job.xsize;
+        tile.height = job.ysize;
+        tile.offset = (uint32_t)(ftello(fid) & 0x0FFFFFFFF);
+        // the JNX tile is stored without the JPEG SOI marker
+        tile.size   = jpg.size() - 2;
+        fwrite(&jpg[2], tile.size, 1, fid);
+
+        {
+            std::lock_guard<std::mutex> lock(pipeline.mutex);
+            pipeline.nextWrite = tileCnt + 1;
+            pipeline.tileWritten.notify_all();
         }
+
+        printProgress(tileCnt + 1, tilesTotal);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pipeline.mutex);
+        pipeline.abort = !ok;
+        pipeline.tileWritten.notify_all();
+    }
+
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    if(!ok)
+    {
+        fprintf(stderr,"\nError reading tiles from map file\n");
+        exit(-1);
     }
 
     // terminate output file
@@ -0,0 +1,121 @@
+/**********************************************************************************************
+    Copyright (C) 2020 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "TestHelper.h"
+#include "test_QMapShack.h"
+
+#include "map/CTileRequestScheduler.h"
+
+#include <QtCore>
+
+/*
+    Stand-in for a tile server. It answers all pending requests the
+    scheduler hands out. The answered urls are returned in request order.
+ */
+static QStringList serveTiles(CTileRequestScheduler& scheduler)
+{
+    QStringList served;
+
+    QString url;
+    while(scheduler.takeNext(url))
+    {
+        served << url;
+    }
+
+    for(const QString& tile : served)
+    {
+        scheduler.finished(tile, false);
+    }
+
+    return served;
+}
+
+void test_QMapShack::_tileRequestScheduler()
+{
+    const QString& tile1 = "http://a.example/tile1.png";
+    const QString& tile2 = "http://a.example/tile2.png";
+    const QString& tile3 = "http://a.example/tile3.png";
+    const QString& tile4 = "http://b.example/tile4.png";
+
+    CTileRequestScheduler scheduler(2);
+
+    // the tiles are requested by priority, but not more than 2 per host at once
+    scheduler.beginCycle();
+    SUBVERIFY(scheduler.add(tile3, 3), "tile3 rejected");
+    SUBVERIFY(scheduler.add(tile1, 1), "tile1 rejected");
+    SUBVERIFY(scheduler.add(tile4, 4), "tile4 rejected");
+    SUBVERIFY(scheduler.add(tile2, 2), "tile2 rejected");
+    SUBVERIFY(scheduler.endCycle().isEmpty(), "stale urls in the first cycle");
+
+    QString url;
+    SUBVERIFY(scheduler.takeNext(url), "no url to request");
+    VERIFY_EQUAL(tile1, url);
+    SUBVERIFY(scheduler.takeNext(url), "no url to request");
+    VERIFY_EQUAL(tile2, url);
+    SUBVERIFY(scheduler.takeNext(url), "no url to request");
+    VERIFY_EQUAL(tile4, url);
+    SUBVERIFY(!scheduler.takeNext(url), "host limit exceeded");
+    VERIFY_EQUAL(3, scheduler.countPending());
+    VERIFY_EQUAL(1, scheduler.countQueued());
+
+    // a redraw of the same viewport must not request pending tiles again
+    scheduler.beginCycle();
+    SUBVERIFY(!scheduler.add(tile1, 1), "pending tile1 added again");
+    SUBVERIFY(!scheduler.add(tile2, 2), "pending tile2 added again");
+    SUBVERIFY(!scheduler.add(tile4, 4), "pending tile4 added again");
+    SUBVERIFY(scheduler.add(tile3, 3), "tile3 rejected");
+    SUBVERIFY(!scheduler.add(tile3, 3), "queued tile3 added again");
+    SUBVERIFY(scheduler.endCycle().isEmpty(), "stale urls for the same viewport");
+    VERIFY_EQUAL(quint32(4), scheduler.getStats().duplicates);
+
+    // the viewport moved away from tile2 and tile4
+    scheduler.beginCycle();
+    scheduler.add(tile1, 1);
+    const QStringList& stale = scheduler.endCycle();
+    VERIFY_EQUAL(0, scheduler.countQueued());
+    VERIFY_EQUAL(2, stale.size());
+    SUBVERIFY(stale.contains(tile2) && stale.contains(tile4), "wrong stale urls");
+
+    for(const QString& tile : stale)
+    {
+        SUBVERIFY(scheduler.canceled(tile), "stale url not pending");
+    }
+    SUBVERIFY(!scheduler.canceled(tile2), "tile2 canceled twice");
+    VERIFY_EQUAL(quint32(2), scheduler.getStats().canceled);
+
+    // the server answers tile1, which is not requested again afterwards
+    SUBVERIFY(scheduler.finished(tile1, false), "tile1 not pending");
+    SUBVERIFY(!scheduler.finished(tile1, false), "tile1 finished twice");
+    SUBVERIFY(scheduler.isIdle(), "scheduler not idle");
+
+    // a failed request frees its slot of the host limit, too
+    scheduler.beginCycle();
+    scheduler.add(tile1, 1);
+    scheduler.add(tile2, 2);
+    scheduler.add(tile3, 3);
+    scheduler.endCycle();
+    SUBVERIFY(scheduler.takeNext(url), "no url to request");
+    SUBVERIFY(scheduler.finished(url, true), "failed url not pending");
+    SUBVERIFY(serveTiles(scheduler) == QStringList({tile2, tile3}), "tiles not served by priority");
+    SUBVERIFY(scheduler.isIdle(), "scheduler not idle");
+
+    const CTileRequestScheduler::stats_t& stats = scheduler.getStats();
+    VERIFY_EQUAL(quint32(6), stats.requested);
+    VERIFY_EQUAL(quint32(3), stats.finished);
+    VERIFY_EQUAL(quint32(1), stats.failed);
+}
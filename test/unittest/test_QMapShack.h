@@ -70,6 +70,9 @@ class test_QMapShack : public QObject
     // CGisItemTrk
     void _filterDeleteExtension();
 
+    // CTileRequestScheduler
+    void _tileRequestScheduler();
+
 private slots:
     void initTestCase();
 
@@ -82,4 +85,5 @@ private slots:
     void testreadExtGarminTPX1_tp1()    { TCWRAPPER( _readExtGarminTPX1_tp1()    ) }
     void testreadValidFitFiles()        { TCWRAPPER( _readValidFitFiles()        ) }
     void testfilterDeleteExtension()    { TCWRAPPER( _filterDeleteExtension()    ) }
+    void testtileRequestScheduler()     { TCWRAPPER( _tileRequestScheduler()     ) }
 };